@@ -11,6 +11,6 @@ public class ArenaBattle : ModuleRules
 		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "HeadMountedDisplay", 
 			"EnhancedInput", "UMG", "NavigationSystem", "AIModule", "GameplayTasks" });
 
-		PrivateDependencyModuleNames.AddRange(new string[] { "ArenaBattleSetting" });
+		PrivateDependencyModuleNames.AddRange(new string[] { "ArenaBattleSetting", "Slate", "SlateCore", "Json" });
     }
 }
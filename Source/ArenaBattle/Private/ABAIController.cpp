@@ -36,6 +36,7 @@ void AABAIController::RunAI()
 	if (UseBlackboard(BBAsset, BlackboardComponent))
 	{
 		Blackboard->SetValueAsVector(HomePosKey, GetPawn()->GetActorLocation());
+		Blackboard->ClearValue(TargetKey);
 		if (!RunBehaviorTree(BTAsset))
 			ABLOG(Error, TEXT("AIController couldn't run behavior tree!"));
 	}
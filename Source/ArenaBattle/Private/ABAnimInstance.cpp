@@ -3,6 +3,8 @@
 
 #include "ABAnimInstance.h"
 
+DECLARE_CYCLE_STAT(TEXT("Anim Instance Update"), STAT_ABAnimInstanceUpdate, STATGROUP_ArenaBattle);
+
 UABAnimInstance::UABAnimInstance()
 {
 	CurrentPawnSpeed = 0.0f;
@@ -18,6 +20,8 @@ UABAnimInstance::UABAnimInstance()
 
 void UABAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
 {
+	AB_SCOPE_CYCLE_COUNTER(STAT_ABAnimInstanceUpdate);
+
 	Super::NativeUpdateAnimation(DeltaSeconds);
 
 	auto Pawn = TryGetPawnOwner();
@@ -0,0 +1,347 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ABBenchmarkSubsystem.h"
+#include "ABCharacter.h"
+#include "ABCharacterPoolSubsystem.h"
+#include "ABPerceptionSubsystem.h"
+#include "ABRandomSubsystem.h"
+#include "ABSectionGridSubsystem.h"
+#include "ABSectionStreamingSubsystem.h"
+#include "Kismet/GameplayStatics.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+#include "Stats/StatsData.h"
+
+namespace ABBenchmark
+{
+	static float Percentile(TArray<float> Values, float Percent)
+	{
+		if (Values.Num() == 0)
+			return 0.0f;
+
+		Values.Sort();
+		const int32 Index = FMath::Clamp(FMath::CeilToInt(Percent / 100.0f * Values.Num()) - 1, 0, Values.Num() - 1);
+		return Values[Index];
+	}
+
+	static void WriteDistribution(TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>& Writer, const TCHAR* Name, const TArray<float>& Values)
+	{
+		double Total = 0.0;
+		for (float Value : Values)
+			Total += Value;
+
+		Writer.WriteObjectStart(Name);
+		Writer.WriteValue(TEXT("mean"), Values.Num() > 0 ? Total / Values.Num() : 0.0);
+		Writer.WriteValue(TEXT("p50"), Percentile(Values, 50.0f));
+		Writer.WriteValue(TEXT("p90"), Percentile(Values, 90.0f));
+		Writer.WriteValue(TEXT("p99"), Percentile(Values, 99.0f));
+		Writer.WriteValue(TEXT("max"), Percentile(Values, 100.0f));
+		Writer.WriteObjectEnd();
+	}
+
+	static double ToMB(uint64 Bytes)
+	{
+		return Bytes / (1024.0 * 1024.0);
+	}
+}
+
+bool UABBenchmarkSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return Super::ShouldCreateSubsystem(Outer) && FParse::Param(FCommandLine::Get(), TEXT("ABBenchmark"));
+}
+
+void UABBenchmarkSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+	FParse::Value(CommandLine, TEXT("ABBenchSections="), SectionRadius);
+	FParse::Value(CommandLine, TEXT("ABBenchNPCs="), NumNPCs);
+	FParse::Value(CommandLine, TEXT("ABBenchWarmup="), WarmupFrames);
+	FParse::Value(CommandLine, TEXT("ABBenchFrames="), MeasuredFrames);
+
+	if (!FParse::Value(CommandLine, TEXT("ABBenchReport="), ReportPath))
+		ReportPath = FPaths::ProjectSavedDir() / TEXT("Benchmarks") / FString::Printf(TEXT("ArenaBattle-%s.json"), *FDateTime::Now().ToString());
+}
+
+void UABBenchmarkSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	ABLOG(Warning, TEXT("Benchmark : %d section radius, %d NPCs, %d + %d frames -> %s"),
+		SectionRadius, NumNPCs, WarmupFrames, MeasuredFrames, *ReportPath);
+
+#if STATS
+	// Makes the stats thread publish the ArenaBattle group every frame so SampleStats can read it.
+	GEngine->Exec(&InWorld, TEXT("stat ArenaBattle"));
+#endif
+
+	ActorSpawnedHandle = InWorld.AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateWeakLambda(this, [this](AActor* Actor)
+	{
+		ActorsSpawned++;
+	}));
+
+	LastFrameTime = FPlatformTime::Seconds();
+}
+
+void UABBenchmarkSubsystem::Deinitialize()
+{
+	if (nullptr != GetWorld())
+		GetWorld()->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+
+	Super::Deinitialize();
+}
+
+void UABBenchmarkSubsystem::Tick(float DeltaTime)
+{
+	const double Now         = FPlatformTime::Seconds();
+	const float  FrameTimeMs = (float)((Now - LastFrameTime) * 1000.0);
+	LastFrameTime = Now;
+
+	if (bFinished)
+		return;
+
+	// Nothing is measured until the player has its profile and skin and can actually fight.
+	auto Player = Cast<AABCharacter>(UGameplayStatics::GetPlayerCharacter(GetWorld(), 0));
+	if (nullptr == Player || Player->GetCharacterState() != ECharacterState::READY)
+		return;
+
+	if (!bStarted)
+		StartScenario(Player);
+
+	DriveBot(Player);
+	while (LiveNPCs < NumNPCs)
+	{
+		if (!SpawnNPC())
+			break;
+	}
+
+	FrameIndex++;
+	if (FrameIndex <= WarmupFrames)
+		return;
+
+	SampleFrame(FrameTimeMs);
+	SampleStats();
+
+	if (FrameIndex >= WarmupFrames + MeasuredFrames)
+	{
+		WriteReport();
+		bFinished = true;
+		FPlatformMisc::RequestExit(false);
+	}
+}
+
+TStatId UABBenchmarkSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UABBenchmarkSubsystem, STATGROUP_ArenaBattle);
+}
+
+bool UABBenchmarkSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UABBenchmarkSubsystem::StartScenario(AABCharacter* Player)
+{
+	bStarted = true;
+	Origin   = Player->GetActorLocation();
+
+	auto SectionGrid      = GetWorld()->GetSubsystem<UABSectionGridSubsystem>();
+	auto SectionStreaming = GetWorld()->GetSubsystem<UABSectionStreamingSubsystem>();
+	if (nullptr == SectionGrid || nullptr == SectionStreaming || !SectionGrid->IsGridInitialized())
+	{
+		ABLOG(Warning, TEXT("No section grid in this map; benchmarking NPCs only."));
+		return;
+	}
+
+	const FIntPoint Center = SectionGrid->WorldToCell(Origin);
+	for (int32 X = -SectionRadius; X <= SectionRadius; ++X)
+	{
+		for (int32 Y = -SectionRadius; Y <= SectionRadius; ++Y)
+		{
+			const FIntPoint Cell = Center + FIntPoint(X, Y);
+			if (SectionGrid->IsCellOccupied(Cell))
+				continue;
+
+			if (nullptr != SectionStreaming->AcquireSection(Cell, FABSectionCell()))
+				SectionsSpawned++;
+		}
+	}
+}
+
+bool UABBenchmarkSubsystem::SpawnNPC()
+{
+	auto CharacterPool = GetWorld()->GetSubsystem<UABCharacterPoolSubsystem>();
+	ABCHECK(nullptr != CharacterPool, false);
+
+	FRandomStream& SpawnStream = UABRandomSubsystem::GetStream(this, EABRandomStream::SPAWN);
+	const float    Angle       = SpawnStream.FRandRange(0.0f, 2.0f * PI);
+	const float    Distance    = SpawnStream.FRandRange(0.25f, 1.0f) * NPCSpawnRadius;
+	const FVector  Location    = Origin + FVector(FMath::Cos(Angle) * Distance, FMath::Sin(Angle) * Distance, 0.0f);
+
+	AABCharacter* NPC = CharacterPool->Acquire(Location, FRotator(0.0f, SpawnStream.FRandRange(0.0f, 360.0f), 0.0f));
+	ABCHECK(nullptr != NPC, false);
+
+	NPC->OnCharacterRemoved.AddUObject(this, &UABBenchmarkSubsystem::OnNPCRemoved);
+	LiveNPCs++;
+	NPCsSpawned++;
+	return true;
+}
+
+void UABBenchmarkSubsystem::OnNPCRemoved(AABCharacter* NPC)
+{
+	LiveNPCs--;
+	NPCsKilled++;
+}
+
+void UABBenchmarkSubsystem::DriveBot(AABCharacter* Player)
+{
+	// The bot never dies, so every run lasts the full frame count.
+	Player->SetCanBeDamaged(false);
+
+	auto Perception = GetWorld()->GetSubsystem<UABPerceptionSubsystem>();
+	ABCHECK(nullptr != Perception);
+
+	TArray<AABCharacter*> Nearby;
+	Perception->QueryCharacters(Player->GetActorLocation(), NPCSpawnRadius * 2.0f, Nearby);
+
+	AABCharacter* Target = nullptr;
+	float NearestDistSq  = BIG_NUMBER;
+	for (AABCharacter* Character : Nearby)
+	{
+		if (Character == Player || Character->GetCharacterState() != ECharacterState::READY)
+			continue;
+
+		const float DistSq = FVector::DistSquared2D(Player->GetActorLocation(), Character->GetActorLocation());
+		if (DistSq < NearestDistSq)
+		{
+			Target        = Character;
+			NearestDistSq = DistSq;
+		}
+	}
+
+	if (nullptr == Target)
+		return;
+
+	FVector ToTarget = Target->GetActorLocation() - Player->GetActorLocation();
+	ToTarget.Z = 0.0f;
+
+	if (ToTarget.Size() > Player->GetFinalAttackRange() + 50.0f)
+	{
+		Player->AddMovementInput(ToTarget.GetSafeNormal());
+		return;
+	}
+
+	if (nullptr != Player->GetController())
+		Player->GetController()->SetControlRotation(ToTarget.Rotation());
+	Player->SetActorRotation(ToTarget.Rotation());
+	Player->Attack();
+	BotAttackInputs++;
+}
+
+void UABBenchmarkSubsystem::SampleFrame(float FrameTimeMs)
+{
+	FrameMs.Add(FrameTimeMs);
+	GameThreadMs.Add(FPlatformTime::ToMilliseconds(GGameThreadTime));
+
+	const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+	PeakUsedPhysical = FMath::Max<uint64>(PeakUsedPhysical, MemoryStats.UsedPhysical);
+	PeakUsedVirtual  = FMath::Max<uint64>(PeakUsedVirtual, MemoryStats.UsedVirtual);
+}
+
+void UABBenchmarkSubsystem::SampleStats()
+{
+#if STATS
+	const FGameThreadStatsData* ViewData = FLatestGameThreadStatsData::Get().Latest;
+	if (nullptr == ViewData)
+		return;
+
+	const int32 GroupIndex = ViewData->GroupNames.IndexOfByKey(FName(TEXT("STATGROUP_ArenaBattle")));
+	if (!ViewData->ActiveStatGroups.IsValidIndex(GroupIndex))
+		return;
+
+	const FActiveStatGroupInfo& Group = ViewData->ActiveStatGroups[GroupIndex];
+	for (const FComplexStatMessage& Message : Group.FlatAggregate)
+	{
+		FStatSample& Sample = CycleStats.FindOrAdd(Message.GetShortName().ToString());
+		const double Ms = FPlatformTime::ToMilliseconds(Message.GetValue_Duration(EComplexStatField::IncAve));
+
+		Sample.TotalMs += Ms;
+		Sample.MaxMs    = FMath::Max(Sample.MaxMs, Ms);
+		Sample.Calls   += Message.GetValue_CallCount(EComplexStatField::IncAve);
+		Sample.Frames++;
+	}
+
+	// Counters and memory stats are reported as their value on the last measured frame.
+	for (const TArray<FComplexStatMessage>* Aggregate : { &Group.CountersAggregate, &Group.MemoryAggregate })
+	{
+		for (const FComplexStatMessage& Message : *Aggregate)
+		{
+			const bool bDouble = Message.NameAndInfo.GetField<EStatDataType>() == EStatDataType::ST_double;
+			CounterStats.Add(Message.GetShortName().ToString(),
+				bDouble ? Message.GetValue_double(EComplexStatField::IncAve) : (double)Message.GetValue_int64(EComplexStatField::IncAve));
+		}
+	}
+#endif
+}
+
+void UABBenchmarkSubsystem::WriteReport()
+{
+	FString Json;
+	auto Writer = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&Json);
+
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("map"), GetWorld()->GetMapName());
+	Writer->WriteValue(TEXT("buildConfig"), LexToString(FApp::GetBuildConfiguration()));
+	Writer->WriteValue(TEXT("seed"), GetWorld()->GetSubsystem<UABRandomSubsystem>()->GetSeed());
+	Writer->WriteValue(TEXT("sectionRadius"), SectionRadius);
+	Writer->WriteValue(TEXT("npcs"), NumNPCs);
+	Writer->WriteValue(TEXT("warmupFrames"), WarmupFrames);
+	Writer->WriteValue(TEXT("measuredFrames"), FrameMs.Num());
+
+	ABBenchmark::WriteDistribution(*Writer, TEXT("frameMs"), FrameMs);
+	ABBenchmark::WriteDistribution(*Writer, TEXT("gameThreadMs"), GameThreadMs);
+
+	Writer->WriteObjectStart(TEXT("spawns"));
+	Writer->WriteValue(TEXT("npcsSpawned"), NPCsSpawned);
+	Writer->WriteValue(TEXT("npcsKilled"), NPCsKilled);
+	Writer->WriteValue(TEXT("sectionsSpawned"), SectionsSpawned);
+	Writer->WriteValue(TEXT("actorsSpawned"), ActorsSpawned);
+	Writer->WriteValue(TEXT("botAttackInputs"), BotAttackInputs);
+	Writer->WriteObjectEnd();
+
+	const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+	Writer->WriteObjectStart(TEXT("memoryMB"));
+	Writer->WriteValue(TEXT("peakUsedPhysical"), ABBenchmark::ToMB(PeakUsedPhysical));
+	Writer->WriteValue(TEXT("peakUsedVirtual"), ABBenchmark::ToMB(PeakUsedVirtual));
+	Writer->WriteValue(TEXT("processPeakUsedPhysical"), ABBenchmark::ToMB(MemoryStats.PeakUsedPhysical));
+	Writer->WriteObjectEnd();
+
+	CycleStats.KeySort(TLess<FString>());
+	Writer->WriteObjectStart(TEXT("stats"));
+	for (const TPair<FString, FStatSample>& Pair : CycleStats)
+	{
+		const FStatSample& Sample = Pair.Value;
+		Writer->WriteObjectStart(Pair.Key);
+		Writer->WriteValue(TEXT("avgMs"), Sample.TotalMs / Sample.Frames);
+		Writer->WriteValue(TEXT("maxMs"), Sample.MaxMs);
+		Writer->WriteValue(TEXT("callsPerFrame"), (double)Sample.Calls / Sample.Frames);
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteObjectEnd();
+
+	CounterStats.KeySort(TLess<FString>());
+	Writer->WriteObjectStart(TEXT("counters"));
+	for (const TPair<FString, double>& Pair : CounterStats)
+		Writer->WriteValue(Pair.Key, Pair.Value);
+	Writer->WriteObjectEnd();
+
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	if (FFileHelper::SaveStringToFile(Json, *ReportPath))
+		ABLOG(Warning, TEXT("Benchmark report written to %s"), *ReportPath);
+	else
+		ABLOG(Error, TEXT("Failed to write benchmark report %s"), *ReportPath);
+}
@@ -11,12 +11,74 @@
 #include "ABAIController.h"
 #include "ABGameInstance.h"
 #include "ABCharacterSetting.h"
-#include "Engine/AssetManager.h"
 #include "ABPlayerController.h"
 #include "ABSection.h"
 #include "ABPlayerState.h"
 #include "ABHUDWidget.h"
 #include "ABGameMode.h"
+#include "ABPerceptionSubsystem.h"
+#include "ABSignificanceSubsystem.h"
+#include "ABCharacterPoolSubsystem.h"
+#include "ABCharacterAssetCache.h"
+#include "ABRandomSubsystem.h"
+#include "ABCombatHitTestSubsystem.h"
+#include "ABCombatEventSubsystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Attack Check"), STAT_ABAttackCheck, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Attack Checks"), STAT_ABAttackChecks, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Attack Checks (Async)"), STAT_ABAttackChecksAsync, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Attack Targets Hit"), STAT_ABAttackTargetsHit, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Attack Hits Deduplicated"), STAT_ABAttackHitsDeduplicated, STATGROUP_ArenaBattle);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Attack Trace Game Thread (Sync, us/check)"), STAT_ABAttackTraceSyncUs, STATGROUP_ArenaBattle);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Attack Trace Game Thread (Async, us/check)"), STAT_ABAttackTraceAsyncUs, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Weapon Actors Spawned"), STAT_ABWeaponActorsSpawned, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Weapon Swaps"), STAT_ABWeaponSwaps, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Spawns Ready From Cache"), STAT_ABSpawnsPreloaded, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Spawns Waiting On Load"), STAT_ABSpawnsOnDemand, STATGROUP_ArenaBattle);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Spawn Time To Ready (ms)"), STAT_ABSpawnTimeToReady, STATGROUP_ArenaBattle);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Level Open To Controllable (ms)"), STAT_ABPlayerControllableTime, STATGROUP_ArenaBattle);
+
+static TAutoConsoleVariable<int32> CVarCombatAsyncTrace
+(
+	TEXT("ab.Combat.AsyncTrace"),
+	1,
+	TEXT("1 : Attack hit checks queue an async sweep and apply damage when it completes next frame.\n")
+	TEXT("0 : Attack hit checks run a blocking sweep inside the anim notify."),
+	ECVF_Default
+);
+
+namespace ABCombat
+{
+	// Game thread cost of issuing one attack sweep in each mode, averaged over the frame's checks.
+	static double SyncTraceUs  = 0.0;
+	static double AsyncTraceUs = 0.0;
+	static int32  SyncTraces   = 0;
+	static int32  AsyncTraces  = 0;
+	static uint64 StatFrame    = 0;
+
+	static void RecordTraceCost(bool bAsync, double Seconds)
+	{
+		if (StatFrame != GFrameCounter)
+		{
+			SyncTraceUs  = 0.0;
+			AsyncTraceUs = 0.0;
+			SyncTraces   = 0;
+			AsyncTraces  = 0;
+			StatFrame    = GFrameCounter;
+		}
+
+		if (bAsync)
+		{
+			AsyncTraceUs += Seconds * 1000000.0;
+			SET_FLOAT_STAT(STAT_ABAttackTraceAsyncUs, AsyncTraceUs / ++AsyncTraces);
+		}
+		else
+		{
+			SyncTraceUs += Seconds * 1000000.0;
+			SET_FLOAT_STAT(STAT_ABAttackTraceSyncUs, SyncTraceUs / ++SyncTraces);
+		}
+	}
+}
 
 // Sets default values
 AABCharacter::AABCharacter()
@@ -27,20 +89,15 @@ AABCharacter::AABCharacter()
 	SpringArm	  = CreateDefaultSubobject<USpringArmComponent>(TEXT("SPRINGARM"));
 	Camera		  = CreateDefaultSubobject<UCameraComponent>(TEXT("CAMERA"));
 	CharacterStat = CreateDefaultSubobject<UABCharacterStatComponent>(TEXT("CHARACTERSTAT"));
-	HPBarWidget   = CreateDefaultSubobject<UWidgetComponent>(TEXT("HPBARWIDGET"));
 
 	SpringArm  ->SetupAttachment(GetCapsuleComponent());
 	Camera     ->SetupAttachment(SpringArm);
-	HPBarWidget->SetupAttachment(GetMesh());
 
 
 	GetMesh()->SetRelativeLocationAndRotation(FVector(0.0f, 0.0f, -88.0f), FRotator(0.0f, -90.0f, 0.0f));
 	SpringArm->TargetArmLength = 400.0f;
 	SpringArm->SetRelativeRotation(FRotator(-15.0f, 0.0f, 0.0f));
 
-	HPBarWidget->SetRelativeLocation(FVector(0.0f, 0.0f, 180.0f));
-	HPBarWidget->SetWidgetSpace(EWidgetSpace::Screen);
-
 	GetCapsuleComponent()->SetCollisionProfileName(TEXT("ABCharacter"));
 	GetMesh()->SetAnimationMode(EAnimationMode::AnimationBlueprint);
 
@@ -56,13 +113,22 @@ AABCharacter::AABCharacter()
 	if (SK_CARDBOARD.Succeeded())
 		GetMesh()->SetSkeletalMesh(SK_CARDBOARD.Object);
 
-	static ConstructorHelpers::FClassFinder<UUserWidget> UI_HUD
-	(TEXT("/Game/Book/UI/UI_HPBar.UI_HPBar_C"));
-
-	if (UI_HUD.Succeeded())
+	// With the component disabled, UABHPBarOverlayWidget draws every character's bar in one pass instead.
+	if (GetDefault<UABCharacterSetting>()->bUseHPBarWidgetComponent)
 	{
-		HPBarWidget->SetWidgetClass(UI_HUD.Class);
-		HPBarWidget->SetDrawSize(FVector2D(150.0f, 50.0f));
+		HPBarWidget = CreateDefaultSubobject<UWidgetComponent>(TEXT("HPBARWIDGET"));
+		HPBarWidget->SetupAttachment(GetMesh());
+		HPBarWidget->SetRelativeLocation(FVector(0.0f, 0.0f, 180.0f));
+		HPBarWidget->SetWidgetSpace(EWidgetSpace::Screen);
+
+		static ConstructorHelpers::FClassFinder<UUserWidget> UI_HUD
+		(TEXT("/Game/Book/UI/UI_HPBar.UI_HPBar_C"));
+
+		if (UI_HUD.Succeeded())
+		{
+			HPBarWidget->SetWidgetClass(UI_HUD.Class);
+			HPBarWidget->SetDrawSize(FVector2D(150.0f, 50.0f));
+		}
 	}
 
 	SetControlMode(EControlMode::TPS);
@@ -84,7 +150,8 @@ AABCharacter::AABCharacter()
 	AssetIndex = 4;
 
 	SetActorHiddenInGame(true);
-	HPBarWidget->SetHiddenInGame(true);
+	if (nullptr != HPBarWidget)
+		HPBarWidget->SetHiddenInGame(true);
 	SetCanBeDamaged(false);
 	
 	DeadTimer = 3.0f;
@@ -114,7 +181,8 @@ void AABCharacter::SetCharacterState(ECharacterState NewState)
 			CharacterStat->SetNewLevel(FinalLevel);
 		}
 		SetActorHiddenInGame(true);
-		HPBarWidget->SetHiddenInGame(true);
+		if (nullptr != HPBarWidget)
+			HPBarWidget->SetHiddenInGame(true);
 		SetCanBeDamaged(false);
 		break;
 	}
@@ -123,19 +191,28 @@ void AABCharacter::SetCharacterState(ECharacterState NewState)
 	case ECharacterState::READY:
 	{
 		SetActorHiddenInGame(false);
-		HPBarWidget->SetHiddenInGame(false);
+		if (nullptr != HPBarWidget)
+			HPBarWidget->SetHiddenInGame(false);
 		SetCanBeDamaged(true);
 
-		CharacterStat->OnHPIsZero.AddLambda([this]() -> void { SetCharacterState(ECharacterState::DEAD);	});
+		CharacterStat->OnHPIsZero.Remove(HPIsZeroHandle);
+		HPIsZeroHandle = CharacterStat->OnHPIsZero.AddLambda([this]() -> void { SetCharacterState(ECharacterState::DEAD);	});
 
-		auto CharacterWidget = Cast<UABCharacterWidget>(HPBarWidget->GetUserWidgetObject());
-		CharacterWidget->BindCharacterStat(CharacterStat);
+		if (nullptr != HPBarWidget)
+		{
+			auto CharacterWidget = Cast<UABCharacterWidget>(HPBarWidget->GetUserWidgetObject());
+			CharacterWidget->BindCharacterStat(CharacterStat);
+		}
 
 		if (bIsPlayer)
 		{
 			SetControlMode(EControlMode::QUARTERVIEW);
 			GetCharacterMovement()->MaxWalkSpeed = 600.0f;
 			EnableInput(ABPlayerController);
+
+			const float ControllableMs = GetWorld()->GetRealTimeSeconds() * 1000.0f;
+			SET_FLOAT_STAT(STAT_ABPlayerControllableTime, ControllableMs);
+			ABLOG(Log, TEXT("Player controllable %.2f ms after level open"), ControllableMs);
 		}
 		else
 		{
@@ -152,7 +229,8 @@ void AABCharacter::SetCharacterState(ECharacterState NewState)
 	{
 		SetActorEnableCollision(false);
 		GetMesh()->SetHiddenInGame(false);
-		HPBarWidget->SetHiddenInGame(true);
+		if (nullptr != HPBarWidget)
+			HPBarWidget->SetHiddenInGame(true);
 		ABAnim->SetDeadAnim();
 		SetCanBeDamaged(false);
 
@@ -167,7 +245,15 @@ void AABCharacter::SetCharacterState(ECharacterState NewState)
 			if (bIsPlayer)
 			ABPlayerController->ShowResultUI();
 			else
-				Destroy();
+			{
+				OnCharacterRemoved.Broadcast(this);
+
+				auto CharacterPool = GetWorld()->GetSubsystem<UABCharacterPoolSubsystem>();
+				if (nullptr != CharacterPool)
+					CharacterPool->Release(this);
+				else
+					Destroy();
+			}
 		}), DeadTimer, false);
 
 		break;
@@ -211,21 +297,136 @@ void AABCharacter::BeginPlay()
 	else
 		ABAIController = Cast<AABAIController>(GetController());
 
+	if (bInPool)
+		ReturnToPool();
+	else
+		StartLoading();
+
+	auto Perception = GetWorld()->GetSubsystem<UABPerceptionSubsystem>();
+	if (nullptr != Perception)
+		Perception->RegisterCharacter(this);
+
+	auto Significance = GetWorld()->GetSubsystem<UABSignificanceSubsystem>();
+	if (nullptr != Significance && !bIsPlayer)
+		Significance->RegisterCharacter(this);
+}
+
+void AABCharacter::StartLoading(int32 PreloadedAssetIndex, TSharedPtr<FABSkinHandle> PreloadHandle)
+{
 	auto DefaultSetting = GetDefault<UABCharacterSetting>();
 
 	if (bIsPlayer)
 	{
 		auto ABPlayerState = Cast<AABPlayerState>(GetPlayerState());
+		if (!ABPlayerState->IsPlayerDataLoaded())
+		{
+			// The profile decides both the skin and the level, so wait for it in LOADING before requesting anything.
+			SetCharacterState(ECharacterState::LOADING);
+			ABPlayerState->OnPlayerDataReady.AddWeakLambda(this, [this]() -> void { StartLoading(); });
+			return;
+		}
+
+		ABPlayerState->OnPlayerDataReady.RemoveAll(this);
 		AssetIndex = ABPlayerState->GetCharacterIndex();
 	}
+	else if (DefaultSetting->CharacterAssets.IsValidIndex(PreloadedAssetIndex))
+		AssetIndex = PreloadedAssetIndex;
 	else
-		AssetIndex = FMath::RandRange(0, DefaultSetting->CharacterAssets.Num() - 1);
+		AssetIndex = UABRandomSubsystem::GetStream(this, EABRandomStream::SKIN).RandRange(0, DefaultSetting->CharacterAssets.Num() - 1);
 
-	CharacterAssetToLoad = DefaultSetting->CharacterAssets[AssetIndex];
-	AssetStreamingHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad
-	(CharacterAssetToLoad, FStreamableDelegate::CreateUObject(this, &AABCharacter::OnAssetLoadCompleted));
+	LoadingStartTime = FPlatformTime::Seconds();
 	SetCharacterState(ECharacterState::LOADING);
 
+	if (PreloadHandle.IsValid() && PreloadHandle->GetAssetIndex() == AssetIndex)
+		SkinHandle = PreloadHandle;
+	else
+	{
+		auto AssetCache = GetGameInstance()->GetSubsystem<UABCharacterAssetCache>();
+		SkinHandle = AssetCache->RequestSkin(AssetIndex);
+		ABCHECK(SkinHandle.IsValid());
+	}
+
+	if (SkinHandle->BindOnLoaded(FSimpleDelegate::CreateUObject(this, &AABCharacter::OnAssetLoadCompleted)))
+		INC_DWORD_STAT(STAT_ABSpawnsOnDemand);
+	else
+	{
+		INC_DWORD_STAT(STAT_ABSpawnsPreloaded);
+		OnAssetLoadCompleted();
+	}
+}
+
+void AABCharacter::ActivateFromPool(const FVector& Location, const FRotator& Rotation, int32 PreloadedAssetIndex,
+	TSharedPtr<FABSkinHandle> PreloadHandle)
+{
+	ABCHECK(bInPool);
+	bInPool = false;
+
+	SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::ResetPhysics);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(true);
+	GetMesh()->SetComponentTickEnabled(true);
+	GetCharacterMovement()->SetComponentTickEnabled(true);
+	GetCharacterMovement()->SetMovementMode(MOVE_Walking);
+
+	StartLoading(PreloadedAssetIndex, PreloadHandle);
+}
+
+void AABCharacter::ReturnToPool()
+{
+	bInPool = true;
+
+	OnCharacterRemoved.Clear();
+	GetWorldTimerManager().ClearTimer(DeadTimerHandle);
+	SkinHandle.Reset();
+
+	if (nullptr != ABAIController)
+		ABAIController->StopAI();
+
+	UnequipWeapon();
+
+	IsAttacking = false;
+	AttackEndComboState();
+	ABAnim->StopAllMontages(0.0f);
+	ABAnim->SetAliveAnim();
+	LastHitBy = nullptr;
+
+	SetActorHiddenInGame(true);
+	if (nullptr != HPBarWidget)
+		HPBarWidget->SetHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetCanBeDamaged(false);
+	SetActorTickEnabled(false);
+	GetMesh()->SetComponentTickEnabled(false);
+	GetCharacterMovement()->StopMovementImmediately();
+	GetCharacterMovement()->DisableMovement();
+	GetCharacterMovement()->SetComponentTickEnabled(false);
+
+	CurrentState = ECharacterState::PREINIT;
+}
+
+bool AABCharacter::IsInPool() const
+{
+	return bInPool;
+}
+
+void AABCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	auto Perception = GetWorld()->GetSubsystem<UABPerceptionSubsystem>();
+	if (nullptr != Perception)
+		Perception->UnregisterCharacter(this);
+
+	auto Significance = GetWorld()->GetSubsystem<UABSignificanceSubsystem>();
+	if (nullptr != Significance)
+		Significance->UnregisterCharacter(this);
+
+	if (nullptr != WeaponSlot)
+	{
+		WeaponSlot->Destroy();
+		WeaponSlot    = nullptr;
+		CurrentWeapon = nullptr;
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AABCharacter::SetControlMode(EControlMode NewControlMode)
@@ -308,6 +509,7 @@ void AABCharacter::PostInitializeComponents()
 
 	ABAnim->OnMontageEnded.AddDynamic(this, &AABCharacter::OnAttackMontageEnded);
 	ABAnim->OnAttackHitCheck.AddUObject(this, &AABCharacter::AttackCheck);
+	AttackTraceDelegate.BindUObject(this, &AABCharacter::OnAttackTraceCompleted);
 
 	ABAnim->OnNextAttackCheck.AddLambda([this]() -> void
 	{
@@ -336,10 +538,16 @@ float AABCharacter::TakeDamage(float DamageAmount, FDamageEvent const& DamageEve
 	CharacterStat->SetDamage(FinalDamage);
 	if (CurrentState == ECharacterState::DEAD)
 	{
-		if (EventInstigator->IsPlayerController())
+		if (nullptr != EventInstigator && EventInstigator->IsPlayerController())
 		{
 			auto TempABPlayerController = Cast<AABPlayerController>(EventInstigator);
-			TempABPlayerController->NPCKill(this);
+
+			// Inside the combat resolution pass the reward waits until every hit of the frame has landed.
+			auto CombatEvents = GetWorld()->GetSubsystem<UABCombatEventSubsystem>();
+			if (nullptr != CombatEvents && CombatEvents->IsResolving())
+				CombatEvents->QueueKillReward(TempABPlayerController, this);
+			else
+				TempABPlayerController->NPCKill(this);
 		}
 	}
 
@@ -367,23 +575,36 @@ bool AABCharacter::CanSetWeapon()
 	return true;
 }
 
-void AABCharacter::SetWeapon(AABWeapon* NewWeapon)
+void AABCharacter::EquipWeapon(TSubclassOf<AABWeapon> WeaponClass)
 {
+	ABCHECK(nullptr != WeaponClass);
 
-	if (nullptr != CurrentWeapon)
+	// The first pickup spawns the character's only weapon actor. Later pickups re-skin and re-roll it in place.
+	if (nullptr == WeaponSlot)
 	{
-		CurrentWeapon->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
-		CurrentWeapon->Destroy();
-		CurrentWeapon = nullptr;
+		FName WeaponSocket(TEXT("hand_rSocket"));
+		WeaponSlot = GetWorld()->SpawnActorDeferred<AABWeapon>(AABWeapon::StaticClass(), FTransform::Identity, this);
+		ABCHECK(nullptr != WeaponSlot);
+
+		WeaponSlot->ApplyWeaponData(WeaponClass);
+		WeaponSlot->FinishSpawning(FTransform::Identity);
+		WeaponSlot->AttachToComponent(GetMesh(), FAttachmentTransformRules::SnapToTargetNotIncludingScale, WeaponSocket);
+		INC_DWORD_STAT(STAT_ABWeaponActorsSpawned);
 	}
+	else
+		WeaponSlot->ApplyWeaponData(WeaponClass);
 
-	FName WeaponSocket(TEXT("hand_rSocket"));
-	if (nullptr != NewWeapon)
-	{
-		NewWeapon->AttachToComponent(GetMesh(), FAttachmentTransformRules::SnapToTargetNotIncludingScale, WeaponSocket);
-		NewWeapon->SetOwner(this);
-		CurrentWeapon = NewWeapon;
-	}
+	WeaponSlot->SetActorHiddenInGame(false);
+	CurrentWeapon = WeaponSlot;
+	INC_DWORD_STAT(STAT_ABWeaponSwaps);
+}
+
+void AABCharacter::UnequipWeapon()
+{
+	if (nullptr != WeaponSlot)
+		WeaponSlot->SetActorHiddenInGame(true);
+
+	CurrentWeapon = nullptr;
 }
 
 void AABCharacter::UpDown(float NewAxisValue)
@@ -435,10 +656,14 @@ void AABCharacter::ViewChange()
 
 void AABCharacter::OnAssetLoadCompleted()
 {
-	USkeletalMesh* AssetLoaded = Cast<USkeletalMesh>(AssetStreamingHandle->GetLoadedAsset());
-	AssetStreamingHandle.Reset();
+	// The handle is kept so the cache knows this skin is still worn.
+	USkeletalMesh* AssetLoaded = SkinHandle->GetSkin();
 	GetMesh()->SetSkeletalMesh(AssetLoaded);
 
+	const float TimeToReadyMs = (float)((FPlatformTime::Seconds() - LoadingStartTime) * 1000.0);
+	SET_FLOAT_STAT(STAT_ABSpawnTimeToReady, TimeToReadyMs);
+	ABLOG(Log, TEXT("%s ready in %.2f ms (asset %d)"), *GetName(), TimeToReadyMs, AssetIndex);
+
 	SetCharacterState(ECharacterState::READY);
 }
 
@@ -473,6 +698,7 @@ void AABCharacter::AttackStartComboState()
 	CanNextCombo   = true;
 	IsComboInputOn = false;
 	CurrentCombo   = FMath::Clamp<int32>(CurrentCombo + 1, 1, MaxCombo);
+	ComboSectionHitActors.Reset();
 }
 
 void AABCharacter::AttackEndComboState()
@@ -480,28 +706,106 @@ void AABCharacter::AttackEndComboState()
 	IsComboInputOn = false;
 	CanNextCombo   = false;
 	CurrentCombo   = 0;
+	ComboSectionHitActors.Reset();
 }
 
 void AABCharacter::AttackCheck()
 {
-	FHitResult HitResult;
+	AB_SCOPE_CYCLE_COUNTER(STAT_ABAttackCheck);
+	INC_DWORD_STAT(STAT_ABAttackChecks);
+
+	const FVector TraceStart = GetActorLocation();
+	const FVector TraceEnd   = TraceStart + GetActorForwardVector() * GetFinalAttackRange();
+
+	auto CombatHitTest = GetWorld()->GetSubsystem<UABCombatHitTestSubsystem>();
+	if (nullptr != CombatHitTest && UABCombatHitTestSubsystem::IsEnabled())
+	{
+		CombatHitTest->QueueSwing(this, TraceStart, TraceEnd, AttackRadius);
+		return;
+	}
+
+	const double IssueStart = FPlatformTime::Seconds();
+
 	FCollisionQueryParams Params(NAME_None, false, this);
-	bool bResult = GetWorld()->SweepSingleByChannel
+
+	// Only characters respond to the Attack channel. Treating them as overlaps lets one sweep report every target in reach.
+	FCollisionResponseParams ResponseParams;
+	ResponseParams.CollisionResponse.SetAllChannels(ECR_Overlap);
+
+	if (CVarCombatAsyncTrace.GetValueOnGameThread() != 0)
+	{
+		// The sweep runs alongside the rest of the frame; OnAttackTraceCompleted applies the damage next frame.
+		GetWorld()->AsyncSweepByChannel
+		(
+			EAsyncTraceType::Multi,
+			TraceStart,
+			TraceEnd,
+			FQuat::Identity,
+			ECollisionChannel::ECC_GameTraceChannel2,
+			FCollisionShape::MakeSphere(AttackRadius),
+			Params,
+			ResponseParams,
+			&AttackTraceDelegate
+		);
+
+		INC_DWORD_STAT(STAT_ABAttackChecksAsync);
+		ABCombat::RecordTraceCost(true, FPlatformTime::Seconds() - IssueStart);
+		return;
+	}
+
+	TArray<FHitResult> HitResults;
+	GetWorld()->SweepMultiByChannel
 	(
-		HitResult,
-		GetActorLocation(),
-		GetActorLocation() + GetActorForwardVector() * GetFinalAttackRange(),
+		HitResults,
+		TraceStart,
+		TraceEnd,
 		FQuat::Identity,
 		ECollisionChannel::ECC_GameTraceChannel2,
 		FCollisionShape::MakeSphere(AttackRadius),
-		Params
+		Params,
+		ResponseParams
 	);
 
+	ABCombat::RecordTraceCost(false, FPlatformTime::Seconds() - IssueStart);
+	ResolveAttackCheck(HitResults, TraceStart, TraceEnd);
+}
+
+void AABCharacter::OnAttackTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	// The swing no longer counts once its owner has died or gone back to the pool.
+	if (CurrentState != ECharacterState::READY)
+		return;
+
+	ResolveAttackCheck(TraceDatum.OutHits, TraceDatum.Start, TraceDatum.End);
+}
+
+void AABCharacter::ResolveAttackCheck(TArrayView<const FHitResult> Hits, const FVector& TraceStart, const FVector& TraceEnd)
+{
+	// A character can show up more than once in one sweep, and again in later hit windows of the same combo section.
+	TArray<AActor*, TInlineAllocator<8>> Targets;
+	for (const FHitResult& Hit : Hits)
+	{
+		AActor* HitActor = Hit.GetActor();
+		if (!IsValid(HitActor) || HitActor == this)
+			continue;
+
+		if (ComboSectionHitActors.Contains(HitActor))
+		{
+			INC_DWORD_STAT(STAT_ABAttackHitsDeduplicated);
+			continue;
+		}
+
+		ComboSectionHitActors.Add(HitActor);
+		Targets.Add(HitActor);
+	}
+
+	const bool bResult = Targets.Num() > 0;
+
 #if ENABLE_DRAW_DEBUG
 	
-	FVector TraceVec    = GetActorForwardVector() * GetFinalAttackRange();
-	FVector Center      = GetActorLocation() + TraceVec * 0.5f;
-	float HalfHeight    = GetFinalAttackRange() * 0.5f + AttackRadius;
+	FVector TraceVec    = TraceEnd - TraceStart;
+	FVector Center      = TraceStart + TraceVec * 0.5f;
+	float HalfHeight    = TraceVec.Size() * 0.5f + AttackRadius;
 	FQuat CapsuleRot    = FRotationMatrix::MakeFromZ(TraceVec).ToQuat();
 	FColor DrawColor    = bResult ? FColor::Green : FColor::Red;
 	float DebugLifeTime = 3.0f;
@@ -520,13 +824,20 @@ void AABCharacter::AttackCheck()
 
 #endif
 
-	if (bResult)
+	// Damage goes out in one batch once the swing's target list is final, through the frame's combat event queue when it is on.
+	const float AttackDamage = GetFinalAttackDamage();
+	auto CombatEvents = GetWorld()->GetSubsystem<UABCombatEventSubsystem>();
+	const bool bDeferDamage = nullptr != CombatEvents && UABCombatEventSubsystem::IsEnabled();
+
+	for (AActor* Target : Targets)
 	{
-		if (HitResult.GetActor()->IsValidLowLevel())
-		{
-			UGameplayStatics::ApplyDamage(HitResult.GetActor(), GetFinalAttackDamage(), GetController(), this, UDamageType::StaticClass());
-		}
+		if (bDeferDamage)
+			CombatEvents->QueueHit(Target, AttackDamage, GetController(), this);
+		else
+			UGameplayStatics::ApplyDamage(Target, AttackDamage, GetController(), this, UDamageType::StaticClass());
 	}
+
+	INC_DWORD_STAT_BY(STAT_ABAttackTargetsHit, Targets.Num());
 }
 
 void AABCharacter::Turn(float NewAxisValue)
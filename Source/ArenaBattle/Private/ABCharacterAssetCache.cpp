@@ -0,0 +1,217 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ABCharacterAssetCache.h"
+#include "ABCharacterSetting.h"
+#include "Engine/AssetManager.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Skin Cache Resident Skins"), STAT_ABSkinCacheResident, STATGROUP_ArenaBattle);
+DECLARE_MEMORY_STAT(TEXT("Skin Cache Resident Memory"), STAT_ABSkinCacheResidentBytes, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Skin Cache Hits"), STAT_ABSkinCacheHits, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Skin Cache Misses"), STAT_ABSkinCacheMisses, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Skin Cache Evictions"), STAT_ABSkinCacheEvictions, STATGROUP_ArenaBattle);
+
+static FAutoConsoleCommandWithWorldAndArgs CmdDumpSkinCache
+(
+	TEXT("ab.Skins.Dump"),
+	TEXT("Lists every cached character skin with its reference count and resident bytes."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UGameInstance* GameInstance = (nullptr != World) ? World->GetGameInstance() : nullptr;
+		UABCharacterAssetCache* Cache = (nullptr != GameInstance) ? GameInstance->GetSubsystem<UABCharacterAssetCache>() : nullptr;
+		if (nullptr != Cache)
+			Cache->DumpResidentSkins(*GLog);
+	})
+);
+
+FABSkinHandle::~FABSkinHandle()
+{
+	if (Cache.IsValid())
+		Cache->ReleaseSkin(AssetIndex);
+}
+
+bool FABSkinHandle::IsLoaded() const
+{
+	return Cache.IsValid() && Cache->IsSkinLoaded(AssetIndex);
+}
+
+USkeletalMesh* FABSkinHandle::GetSkin() const
+{
+	return Cache.IsValid() ? Cache->GetLoadedSkin(AssetIndex) : nullptr;
+}
+
+bool FABSkinHandle::BindOnLoaded(FSimpleDelegate InOnLoaded)
+{
+	if (IsLoaded())
+		return false;
+
+	OnLoaded = MoveTemp(InOnLoaded);
+	return true;
+}
+
+void UABCharacterAssetCache::Deinitialize()
+{
+	for (auto& Pair : Entries)
+	{
+		if (Pair.Value.StreamableHandle.IsValid())
+			Pair.Value.StreamableHandle->ReleaseHandle();
+	}
+
+	Entries.Reset();
+	UpdateStats();
+
+	Super::Deinitialize();
+}
+
+TSharedPtr<FABSkinHandle> UABCharacterAssetCache::RequestSkin(int32 AssetIndex)
+{
+	FSkinEntry* Entry = FindOrLoadEntry(AssetIndex);
+	ABCHECK(nullptr != Entry, nullptr);
+
+	return MakeHandle(AssetIndex, *Entry);
+}
+
+void UABCharacterAssetCache::DumpResidentSkins(FOutputDevice& Ar) const
+{
+	auto DefaultSetting = GetDefault<UABCharacterSetting>();
+	int64 TotalBytes    = 0;
+
+	for (const auto& Pair : Entries)
+	{
+		const FSkinEntry& Entry = Pair.Value;
+		Ar.Logf(TEXT("[%2d] %-60s refs=%d bytes=%lld %s"), Pair.Key, *DefaultSetting->CharacterAssets[Pair.Key].GetAssetName(),
+			Entry.RefCount, Entry.ResidentBytes, IsSkinLoaded(Pair.Key) ? TEXT("") : TEXT("(loading)"));
+		TotalBytes += Entry.ResidentBytes;
+	}
+
+	Ar.Logf(TEXT("%d skins, %.2f / %d MB"), Entries.Num(), TotalBytes / (1024.0 * 1024.0), ResidentBudgetMB);
+}
+
+TSharedPtr<FABSkinHandle> UABCharacterAssetCache::MakeHandle(int32 AssetIndex, FSkinEntry& Entry)
+{
+	TSharedPtr<FABSkinHandle> Handle = MakeShared<FABSkinHandle>();
+	Handle->AssetIndex = AssetIndex;
+	Handle->Cache      = this;
+
+	Entry.RefCount++;
+	Entry.LastUsedTime = FPlatformTime::Seconds();
+	if (!IsSkinLoaded(AssetIndex))
+		Entry.Waiters.Add(Handle);
+
+	return Handle;
+}
+
+UABCharacterAssetCache::FSkinEntry* UABCharacterAssetCache::FindOrLoadEntry(int32 AssetIndex)
+{
+	auto DefaultSetting = GetDefault<UABCharacterSetting>();
+	ABCHECK(DefaultSetting->CharacterAssets.IsValidIndex(AssetIndex), nullptr);
+
+	FSkinEntry* Entry = Entries.Find(AssetIndex);
+	if (nullptr != Entry)
+	{
+		INC_DWORD_STAT(STAT_ABSkinCacheHits);
+		return Entry;
+	}
+
+	INC_DWORD_STAT(STAT_ABSkinCacheMisses);
+
+	Entry = &Entries.Add(AssetIndex);
+	Entry->StreamableHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(DefaultSetting->CharacterAssets[AssetIndex],
+		FStreamableDelegate::CreateUObject(this, &UABCharacterAssetCache::OnSkinLoaded, AssetIndex));
+
+	return Entry;
+}
+
+void UABCharacterAssetCache::OnSkinLoaded(int32 AssetIndex)
+{
+	FSkinEntry* Entry = Entries.Find(AssetIndex);
+	if (nullptr == Entry)
+		return;
+
+	USkeletalMesh* Skin  = GetLoadedSkin(AssetIndex);
+	Entry->ResidentBytes = (nullptr != Skin) ? Skin->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal) : 0;
+
+	// Callbacks may request or release other skins, so detach the list before running them.
+	TArray<TWeakPtr<FABSkinHandle>> Waiters = MoveTemp(Entry->Waiters);
+	for (const TWeakPtr<FABSkinHandle>& Waiter : Waiters)
+	{
+		TSharedPtr<FABSkinHandle> Handle = Waiter.Pin();
+		if (Handle.IsValid())
+			Handle->OnLoaded.ExecuteIfBound();
+	}
+
+	EnforceBudget();
+	UpdateStats();
+}
+
+void UABCharacterAssetCache::ReleaseSkin(int32 AssetIndex)
+{
+	FSkinEntry* Entry = Entries.Find(AssetIndex);
+	if (nullptr == Entry)
+		return;
+
+	Entry->RefCount--;
+	Entry->LastUsedTime = FPlatformTime::Seconds();
+	ABCHECK(Entry->RefCount >= 0);
+
+	EnforceBudget();
+	UpdateStats();
+}
+
+bool UABCharacterAssetCache::IsSkinLoaded(int32 AssetIndex) const
+{
+	return nullptr != GetLoadedSkin(AssetIndex);
+}
+
+USkeletalMesh* UABCharacterAssetCache::GetLoadedSkin(int32 AssetIndex) const
+{
+	const FSkinEntry* Entry = Entries.Find(AssetIndex);
+	if (nullptr == Entry || !Entry->StreamableHandle.IsValid() || !Entry->StreamableHandle->HasLoadCompleted())
+		return nullptr;
+
+	return Cast<USkeletalMesh>(Entry->StreamableHandle->GetLoadedAsset());
+}
+
+void UABCharacterAssetCache::EnforceBudget()
+{
+	const int64 BudgetBytes = (int64)ResidentBudgetMB * 1024 * 1024;
+
+	int64 TotalBytes = 0;
+	for (const auto& Pair : Entries)
+		TotalBytes += Pair.Value.ResidentBytes;
+
+	while (TotalBytes > BudgetBytes)
+	{
+		int32  VictimIndex    = INDEX_NONE;
+		double OldestUsedTime = DBL_MAX;
+		for (const auto& Pair : Entries)
+		{
+			if (Pair.Value.RefCount == 0 && Pair.Value.LastUsedTime < OldestUsedTime)
+			{
+				VictimIndex    = Pair.Key;
+				OldestUsedTime = Pair.Value.LastUsedTime;
+			}
+		}
+
+		// Everything left is referenced; the budget is exceeded until handles go away.
+		if (INDEX_NONE == VictimIndex)
+			break;
+
+		FSkinEntry Victim = Entries.FindAndRemoveChecked(VictimIndex);
+		if (Victim.StreamableHandle.IsValid())
+			Victim.StreamableHandle->ReleaseHandle();
+
+		TotalBytes -= Victim.ResidentBytes;
+		INC_DWORD_STAT(STAT_ABSkinCacheEvictions);
+	}
+}
+
+void UABCharacterAssetCache::UpdateStats() const
+{
+	int64 TotalBytes = 0;
+	for (const auto& Pair : Entries)
+		TotalBytes += Pair.Value.ResidentBytes;
+
+	SET_DWORD_STAT(STAT_ABSkinCacheResident, Entries.Num());
+	SET_MEMORY_STAT(STAT_ABSkinCacheResidentBytes, TotalBytes);
+}
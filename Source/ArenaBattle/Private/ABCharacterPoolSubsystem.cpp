@@ -0,0 +1,108 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ABCharacterPoolSubsystem.h"
+#include "ABCharacter.h"
+#include "ABGameMode.h"
+#include "ABCharacterAssetCache.h"
+
+DECLARE_CYCLE_STAT(TEXT("Character Pool Acquire"), STAT_ABCharacterPoolAcquire, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Character Pool Hits"), STAT_ABCharacterPoolHits, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Character Pool Misses"), STAT_ABCharacterPoolMisses, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Character Pool Available"), STAT_ABCharacterPoolAvailable, STATGROUP_ArenaBattle);
+
+static const FVector PooledCharacterLocation(0.0f, 0.0f, -10000.0f);
+
+void UABCharacterPoolSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (nullptr == Cast<AABGameMode>(InWorld.GetAuthGameMode()))
+		return;
+
+	const int32 NumToSpawn = FMath::Min(PrewarmCount, MaxPoolSize);
+	for (int32 Index = 0; Index < NumToSpawn; ++Index)
+	{
+		AABCharacter* Character = SpawnPooledCharacter();
+		if (nullptr != Character)
+			AvailableCharacters.Add(Character);
+	}
+
+	SET_DWORD_STAT(STAT_ABCharacterPoolAvailable, AvailableCharacters.Num());
+}
+
+void UABCharacterPoolSubsystem::Deinitialize()
+{
+	AvailableCharacters.Reset();
+	SET_DWORD_STAT(STAT_ABCharacterPoolAvailable, 0);
+
+	Super::Deinitialize();
+}
+
+AABCharacter* UABCharacterPoolSubsystem::Acquire(const FVector& Location, const FRotator& Rotation, int32 PreloadedAssetIndex,
+	TSharedPtr<FABSkinHandle> PreloadHandle)
+{
+	AB_SCOPE_CYCLE_COUNTER(STAT_ABCharacterPoolAcquire);
+
+	AABCharacter* Character = nullptr;
+	while (nullptr == Character && AvailableCharacters.Num() > 0)
+	{
+		Character = AvailableCharacters.Pop(false);
+		if (!IsValid(Character))
+			Character = nullptr;
+	}
+
+	if (nullptr != Character)
+		INC_DWORD_STAT(STAT_ABCharacterPoolHits);
+	else
+	{
+		INC_DWORD_STAT(STAT_ABCharacterPoolMisses);
+		Character = SpawnPooledCharacter();
+		if (nullptr == Character)
+			return nullptr;
+	}
+
+	Character->ActivateFromPool(Location, Rotation, PreloadedAssetIndex, PreloadHandle);
+	SET_DWORD_STAT(STAT_ABCharacterPoolAvailable, AvailableCharacters.Num());
+
+	return Character;
+}
+
+void UABCharacterPoolSubsystem::Release(AABCharacter* Character)
+{
+	ABCHECK(nullptr != Character);
+
+	if (AvailableCharacters.Num() >= MaxPoolSize)
+	{
+		Character->Destroy();
+		return;
+	}
+
+	Character->ReturnToPool();
+	Character->SetActorLocation(PooledCharacterLocation);
+	AvailableCharacters.Add(Character);
+
+	SET_DWORD_STAT(STAT_ABCharacterPoolAvailable, AvailableCharacters.Num());
+}
+
+bool UABCharacterPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+AABCharacter* UABCharacterPoolSubsystem::SpawnPooledCharacter()
+{
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	SpawnParams.bDeferConstruction = true;
+
+	auto Character = GetWorld()->SpawnActor<AABCharacter>(AABCharacter::StaticClass(), PooledCharacterLocation, FRotator::ZeroRotator, SpawnParams);
+	if (nullptr == Character)
+		return nullptr;
+
+	// BeginPlay sees the flag and parks the character instead of starting to load.
+	Character->bInPool = true;
+	Character->FinishSpawning(FTransform(PooledCharacterLocation));
+
+	return Character;
+}
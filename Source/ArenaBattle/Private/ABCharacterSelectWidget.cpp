@@ -3,13 +3,12 @@
 
 #include "ABCharacterSelectWidget.h"
 #include "ABCharacterSetting.h"
-#include "Engine/Assetmanager.h"
+#include "ABCharacterAssetCache.h"
 #include "EngineUtils.h"
 #include "Animation/SkeletalMeshActor.h"
 #include "Components/Button.h"
 #include "Components/EditableTextBox.h"
-#include "ABSaveGame.h"
-#include "ABPlayerState.h"
+#include "ABSaveService.h"
 
 void UABCharacterSelectWidget::NextCharacter(bool bForward)
 {
@@ -18,13 +17,38 @@ void UABCharacterSelectWidget::NextCharacter(bool bForward)
 	if (CurrentIndex == -1)       CurrentIndex = MaxIndex - 1;
 	if (CurrentIndex == MaxIndex) CurrentIndex = 0;
 
-	auto CharacterSetting = GetDefault<UABCharacterSetting>();
-	auto AssetRef = CharacterSetting->CharacterAssets[CurrentIndex];
+	auto AssetCache = GetGameInstance()->GetSubsystem<UABCharacterAssetCache>();
+	DisplayedSkin   = AssetCache->RequestSkin(CurrentIndex);
+	ClickTime       = FPlatformTime::Seconds();
+	ABCHECK(DisplayedSkin.IsValid());
 
-	
-	USkeletalMesh* Asset = UAssetManager::GetStreamableManager().LoadSynchronous<USkeletalMesh>(AssetRef);
+	if (!DisplayedSkin->BindOnLoaded(FSimpleDelegate::CreateUObject(this, &UABCharacterSelectWidget::OnDisplayedSkinLoaded)))
+		OnDisplayedSkinLoaded();
+
+	PrefetchNeighborSkins();
+}
+
+void UABCharacterSelectWidget::PrefetchNeighborSkins()
+{
+	if (MaxIndex <= 0)
+		return;
+
+	// New handles are taken before the old ones drop, so a skin staying in the window is never released.
+	auto AssetCache  = GetGameInstance()->GetSubsystem<UABCharacterAssetCache>();
+	NeighborSkins[0] = AssetCache->RequestSkin((CurrentIndex + MaxIndex - 1) % MaxIndex);
+	NeighborSkins[1] = AssetCache->RequestSkin((CurrentIndex + 1) % MaxIndex);
+}
+
+void UABCharacterSelectWidget::OnDisplayedSkinLoaded()
+{
+	if (!DisplayedSkin.IsValid() || DisplayedSkin->GetAssetIndex() != CurrentIndex || !TargetComponent.IsValid())
+		return;
+
+	USkeletalMesh* Asset = DisplayedSkin->GetSkin();
 	if (nullptr != Asset)
 		TargetComponent->SetSkeletalMesh(Asset);
+
+	ABLOG(Log, TEXT("Character %d displayed %.2f ms after click"), CurrentIndex, (FPlatformTime::Seconds() - ClickTime) * 1000.0);
 }
 
 void UABCharacterSelectWidget::NativeConstruct()
@@ -41,6 +65,8 @@ void UABCharacterSelectWidget::NativeConstruct()
 		break;
 	}
 
+	PrefetchNeighborSkins();
+
 	PrevButton	  = Cast<UButton>(GetWidgetFromName(TEXT("btnPrev")));
 	NextButton	  = Cast<UButton>(GetWidgetFromName(TEXT("btnNext")));
 	ConfirmButton = Cast<UButton>(GetWidgetFromName(TEXT("btnConfirm")));
@@ -66,15 +92,16 @@ void UABCharacterSelectWidget::OnConfirmClicked()
 	FString CharacterName = TextBox->GetText().ToString();
 	if (CharacterName.Len() <= 0 || CharacterName.Len() > 10) return;
 
-	UABSaveGame* NewPlayerData	  = NewObject<UABSaveGame>();
-	NewPlayerData->PlayerName	  = CharacterName;
-	NewPlayerData->Level		  = 1;
-	NewPlayerData->Exp			  = 0;
-	NewPlayerData->HighScore	  = 0;
-	NewPlayerData->CharacterIndex = CurrentIndex;
-
-	auto ABPlayerState = GetDefault<AABPlayerState>();
-	if (UGameplayStatics::SaveGameToSlot(NewPlayerData, ABPlayerState->SaveSlotName, 0))
-		UGameplayStatics::OpenLevel(GetWorld(), TEXT("Gameplay"));
+	FABProfileData NewPlayerData;
+	NewPlayerData.PlayerName	 = CharacterName;
+	NewPlayerData.Level			 = 1;
+	NewPlayerData.Exp			 = 0;
+	NewPlayerData.HighScore		 = 0;
+	NewPlayerData.CharacterIndex = CurrentIndex;
+
+	// The gameplay level's profile load is queued behind this write, so the level can open right away.
+	auto SaveService = GetGameInstance()->GetSubsystem<UABSaveService>();
+	SaveService->SetActiveSlot(SaveService->CreateNewProfile(NewPlayerData));
+	UGameplayStatics::OpenLevel(GetWorld(), TEXT("Gameplay"));
 	
 }
\ No newline at end of file
@@ -8,6 +8,7 @@
 void UABCharacterWidget::BindCharacterStat(UABCharacterStatComponent* NewCharacterStat)
 {
 	CurrentCharacterStat = NewCharacterStat;
+	NewCharacterStat->OnHPChanged.RemoveAll(this);
 	NewCharacterStat->OnHPChanged.AddUObject(this, &UABCharacterWidget::UpdateHPWidget);
 }
 
@@ -0,0 +1,122 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ABCombatEventSubsystem.h"
+#include "ABCharacter.h"
+#include "ABPlayerController.h"
+#include "Kismet/GameplayStatics.h"
+
+DECLARE_CYCLE_STAT(TEXT("Combat Event Resolve"), STAT_ABCombatEventResolve, STATGROUP_ArenaBattle);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Combat Hits Resolved"), STAT_ABCombatHitsResolved, STATGROUP_ArenaBattle);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Combat Hits Dropped"), STAT_ABCombatHitsDropped, STATGROUP_ArenaBattle);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Combat Kill Rewards"), STAT_ABCombatKillRewards, STATGROUP_ArenaBattle);
+
+static TAutoConsoleVariable<int32> CVarCombatDeferredDamage
+(
+	TEXT("ab.Combat.DeferredDamage"),
+	1,
+	TEXT("1 : Attack hits are queued and resolved together once per frame in TG_PostUpdateWork.\n")
+	TEXT("0 : Attack hits apply damage immediately where the swing is resolved."),
+	ECVF_Default
+);
+
+void FABCombatEventTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (nullptr != Target)
+		Target->ResolveEvents();
+}
+
+FString FABCombatEventTickFunction::DiagnosticMessage()
+{
+	return TEXT("UABCombatEventSubsystem::ResolveEvents");
+}
+
+void UABCombatEventSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	TickFunction.Target                = this;
+	TickFunction.TickGroup             = TG_PostUpdateWork;
+	TickFunction.bCanEverTick          = true;
+	TickFunction.bStartWithTickEnabled = true;
+	TickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+}
+
+void UABCombatEventSubsystem::Deinitialize()
+{
+	if (TickFunction.IsTickFunctionRegistered())
+		TickFunction.UnRegisterTickFunction();
+
+	TickFunction.Target = nullptr;
+	PendingHits.Reset();
+	PendingKillRewards.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UABCombatEventSubsystem::IsEnabled()
+{
+	return CVarCombatDeferredDamage.GetValueOnGameThread() != 0;
+}
+
+void UABCombatEventSubsystem::QueueHit(AActor* Target, float Damage, AController* EventInstigator, AActor* DamageCauser)
+{
+	ABCHECK(nullptr != Target);
+	PendingHits.Add({ Target, EventInstigator, DamageCauser, Damage });
+}
+
+bool UABCombatEventSubsystem::IsResolving() const
+{
+	return bResolving;
+}
+
+void UABCombatEventSubsystem::QueueKillReward(AABPlayerController* Killer, AABCharacter* KilledNPC)
+{
+	ABCHECK(nullptr != Killer && nullptr != KilledNPC);
+	PendingKillRewards.Add({ Killer, KilledNPC });
+}
+
+void UABCombatEventSubsystem::ResolveEvents()
+{
+	if (PendingHits.Num() == 0)
+		return;
+
+	AB_SCOPE_CYCLE_COUNTER(STAT_ABCombatEventResolve);
+
+	Swap(PendingHits, ResolvingHits);
+	int32 NumDropped = 0;
+
+	// Hits land in the order they were queued, so the same swings always produce the same deaths and rewards.
+	bResolving = true;
+	for (const FCombatHit& Hit : ResolvingHits)
+	{
+		AActor* Target = Hit.Target.Get();
+		if (!IsValid(Target) || !Target->CanBeDamaged())
+		{
+			// Killed (or pooled) earlier in this pass.
+			NumDropped++;
+			continue;
+		}
+
+		UGameplayStatics::ApplyDamage(Target, Hit.Damage, Hit.EventInstigator.Get(), Hit.DamageCauser.Get(), UDamageType::StaticClass());
+	}
+	bResolving = false;
+
+	SET_DWORD_STAT(STAT_ABCombatHitsResolved, ResolvingHits.Num() - NumDropped);
+	SET_DWORD_STAT(STAT_ABCombatHitsDropped, NumDropped);
+	SET_DWORD_STAT(STAT_ABCombatKillRewards, PendingKillRewards.Num());
+
+	ResolvingHits.Reset();
+
+	for (const FKillReward& Reward : PendingKillRewards)
+	{
+		if (Reward.Killer.IsValid() && Reward.KilledNPC.IsValid())
+			Reward.Killer->NPCKill(Reward.KilledNPC.Get());
+	}
+	PendingKillRewards.Reset();
+}
+
+bool UABCombatEventSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
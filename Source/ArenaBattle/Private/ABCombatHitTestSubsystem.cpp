@@ -0,0 +1,375 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ABCombatHitTestSubsystem.h"
+#include "ABCharacter.h"
+#include "ABPerceptionSubsystem.h"
+#include "Components/CapsuleComponent.h"
+
+DECLARE_CYCLE_STAT(TEXT("Combat Hit Test"), STAT_ABCombatHitTest, STATGROUP_ArenaBattle);
+DECLARE_CYCLE_STAT(TEXT("Combat Hit Test Kernel"), STAT_ABCombatHitTestKernel, STATGROUP_ArenaBattle);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Combat Hit Test Swings"), STAT_ABCombatHitTestSwings, STATGROUP_ArenaBattle);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Combat Hit Test Combatants"), STAT_ABCombatHitTestCombatants, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Combat Hit Test Physics Mismatches"), STAT_ABCombatHitTestMismatches, STATGROUP_ArenaBattle);
+
+static TAutoConsoleVariable<int32> CVarCombatAnalyticHitTest
+(
+	TEXT("ab.Combat.AnalyticHitTest"),
+	1,
+	TEXT("1 : Attack swings are batched and tested against combatant capsules analytically at the end of the frame.\n")
+	TEXT("0 : Attack swings sweep the physics scene (see ab.Combat.AsyncTrace)."),
+	ECVF_Default
+);
+
+static TAutoConsoleVariable<int32> CVarCombatValidateHitTest
+(
+	TEXT("ab.Combat.ValidateHitTest"),
+	0,
+	TEXT("1 : Also sweep every analytic swing through the physics scene and log any difference in the characters hit."),
+	ECVF_Cheat
+);
+
+static FAutoConsoleCommand CmdBenchmarkHitTest
+(
+	TEXT("ab.Combat.BenchmarkHitTest"),
+	TEXT("Times the vector and scalar swing hit tests at 1k and 10k combatants. Usage: ab.Combat.BenchmarkHitTest [Swings] [Iterations]\n")
+	TEXT("Their results are checked against each other and against physics by the ArenaBattle.Combat.HitTest automation tests."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const int32 NumSwings  = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 64;
+		const int32 Iterations = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 100;
+
+		UABCombatHitTestSubsystem::RunBenchmark(1000, NumSwings, Iterations);
+		UABCombatHitTestSubsystem::RunBenchmark(10000, NumSwings, Iterations);
+	})
+);
+
+namespace ABCombatHitTest
+{
+	static FORCEINLINE VectorRegister4Float VectorClamp01(const VectorRegister4Float& Value)
+	{
+		return VectorMin(VectorMax(Value, VectorZeroFloat()), VectorOneFloat());
+	}
+}
+
+void FABCombatantBuffer::Reset()
+{
+	CenterX.Reset();
+	CenterY.Reset();
+	CenterZ.Reset();
+	Radius.Reset();
+	AxisHalfLength.Reset();
+	NumCombatants = 0;
+}
+
+int32 FABCombatantBuffer::Add(const FVector& Center, float CapsuleRadius, float CapsuleHalfHeight)
+{
+	if (NumCombatants % 4 == 0)
+	{
+		CenterX.AddZeroed(4);
+		CenterY.AddZeroed(4);
+		CenterZ.AddZeroed(4);
+		Radius.AddZeroed(4);
+		AxisHalfLength.AddZeroed(4);
+	}
+
+	const int32 Index = NumCombatants++;
+	CenterX[Index]        = (float)Center.X;
+	CenterY[Index]        = (float)Center.Y;
+	CenterZ[Index]        = (float)Center.Z;
+	Radius[Index]         = CapsuleRadius;
+	AxisHalfLength[Index] = FMath::Max(CapsuleHalfHeight - CapsuleRadius, 0.0f);
+	return Index;
+}
+
+int32 FABCombatantBuffer::Num() const
+{
+	return NumCombatants;
+}
+
+// Closest points between the swing segment S0 + D1 * S and each combatant axis P2 + D2 * T, following Ericson's
+// segment-segment test. Every combatant axis is vertical, so D2 = (0, 0, 2H) and most of the dot products collapse.
+// Once T is clamped, S is recomputed from it, which yields the same closest pair without branching per lane.
+void FABCombatantBuffer::TestSwings(TArrayView<const FABSwing> Swings, TArray<FABSwingHit>& OutHits) const
+{
+	AB_SCOPE_CYCLE_COUNTER(STAT_ABCombatHitTestKernel);
+
+	const VectorRegister4Float Zero    = VectorZeroFloat();
+	const VectorRegister4Float Two     = VectorSetFloat1(2.0f);
+	const VectorRegister4Float Epsilon = VectorSetFloat1(KINDA_SMALL_NUMBER);
+
+	for (int32 SwingIndex = 0; SwingIndex < Swings.Num(); ++SwingIndex)
+	{
+		const FABSwing& Swing = Swings[SwingIndex];
+		const FVector3f Start(Swing.Start);
+		const FVector3f Dir(Swing.End - Swing.Start);
+		const float     A = Dir.SizeSquared();
+
+		const VectorRegister4Float S0X  = VectorSetFloat1(Start.X);
+		const VectorRegister4Float S0Y  = VectorSetFloat1(Start.Y);
+		const VectorRegister4Float S0Z  = VectorSetFloat1(Start.Z);
+		const VectorRegister4Float D1X  = VectorSetFloat1(Dir.X);
+		const VectorRegister4Float D1Y  = VectorSetFloat1(Dir.Y);
+		const VectorRegister4Float D1Z  = VectorSetFloat1(Dir.Z);
+		const VectorRegister4Float VA   = VectorSetFloat1(A);
+		const VectorRegister4Float InvA = VectorSetFloat1(A > KINDA_SMALL_NUMBER ? 1.0f / A : 0.0f);
+		const VectorRegister4Float SwingRadius = VectorSetFloat1(Swing.Radius);
+
+		for (int32 Base = 0; Base < NumCombatants; Base += 4)
+		{
+			const VectorRegister4Float H   = VectorLoad(&AxisHalfLength[Base]);
+			const VectorRegister4Float RX  = VectorSubtract(S0X, VectorLoad(&CenterX[Base]));
+			const VectorRegister4Float RY  = VectorSubtract(S0Y, VectorLoad(&CenterY[Base]));
+			const VectorRegister4Float RZ  = VectorAdd(VectorSubtract(S0Z, VectorLoad(&CenterZ[Base])), H);
+			const VectorRegister4Float D2Z = VectorMultiply(Two, H);
+
+			const VectorRegister4Float B = VectorMultiply(D1Z, D2Z);
+			const VectorRegister4Float C = VectorMultiplyAdd(D1X, RX, VectorMultiplyAdd(D1Y, RY, VectorMultiply(D1Z, RZ)));
+			const VectorRegister4Float E = VectorMultiply(D2Z, D2Z);
+			const VectorRegister4Float F = VectorMultiply(D2Z, RZ);
+
+			const VectorRegister4Float Denom = VectorSubtract(VectorMultiply(VA, E), VectorMultiply(B, B));
+			VectorRegister4Float S = VectorDivide(VectorSubtract(VectorMultiply(B, F), VectorMultiply(C, E)), VectorMax(Denom, Epsilon));
+			S = VectorSelect(VectorCompareGT(Denom, Epsilon), ABCombatHitTest::VectorClamp01(S), Zero);
+
+			VectorRegister4Float T = VectorDivide(VectorMultiplyAdd(B, S, F), VectorMax(E, Epsilon));
+			T = VectorSelect(VectorCompareGT(E, Epsilon), ABCombatHitTest::VectorClamp01(T), Zero);
+			S = ABCombatHitTest::VectorClamp01(VectorMultiply(VectorSubtract(VectorMultiply(B, T), C), InvA));
+
+			const VectorRegister4Float DX     = VectorMultiplyAdd(D1X, S, RX);
+			const VectorRegister4Float DY     = VectorMultiplyAdd(D1Y, S, RY);
+			const VectorRegister4Float DZ     = VectorSubtract(VectorMultiplyAdd(D1Z, S, RZ), VectorMultiply(D2Z, T));
+			const VectorRegister4Float DistSq = VectorMultiplyAdd(DX, DX, VectorMultiplyAdd(DY, DY, VectorMultiply(DZ, DZ)));
+			const VectorRegister4Float Reach  = VectorAdd(VectorLoad(&Radius[Base]), SwingRadius);
+
+			uint32 Mask = (uint32)VectorMaskBits(VectorCompareLE(DistSq, VectorMultiply(Reach, Reach)));
+			if (NumCombatants - Base < 4)
+				Mask &= (1u << (NumCombatants - Base)) - 1;
+
+			while (0 != Mask)
+			{
+				OutHits.Add({ SwingIndex, Base + (int32)FMath::CountTrailingZeros(Mask) });
+				Mask &= Mask - 1;
+			}
+		}
+	}
+}
+
+void FABCombatantBuffer::TestSwingsScalar(TArrayView<const FABSwing> Swings, TArray<FABSwingHit>& OutHits) const
+{
+	for (int32 SwingIndex = 0; SwingIndex < Swings.Num(); ++SwingIndex)
+	{
+		const FABSwing& Swing = Swings[SwingIndex];
+		const FVector3f Start(Swing.Start);
+		const FVector3f Dir(Swing.End - Swing.Start);
+		const float     A    = Dir.SizeSquared();
+		const float     InvA = A > KINDA_SMALL_NUMBER ? 1.0f / A : 0.0f;
+
+		for (int32 Index = 0; Index < NumCombatants; ++Index)
+		{
+			const float H   = AxisHalfLength[Index];
+			const float RX  = Start.X - CenterX[Index];
+			const float RY  = Start.Y - CenterY[Index];
+			const float RZ  = Start.Z - CenterZ[Index] + H;
+			const float D2Z = 2.0f * H;
+
+			const float B = Dir.Z * D2Z;
+			const float C = Dir.X * RX + Dir.Y * RY + Dir.Z * RZ;
+			const float E = D2Z * D2Z;
+			const float F = D2Z * RZ;
+
+			const float Denom = A * E - B * B;
+			float S = Denom > KINDA_SMALL_NUMBER ? FMath::Clamp((B * F - C * E) / Denom, 0.0f, 1.0f) : 0.0f;
+			float T = E > KINDA_SMALL_NUMBER ? FMath::Clamp((B * S + F) / E, 0.0f, 1.0f) : 0.0f;
+			S = FMath::Clamp((B * T - C) * InvA, 0.0f, 1.0f);
+
+			const float DX    = RX + Dir.X * S;
+			const float DY    = RY + Dir.Y * S;
+			const float DZ    = RZ + Dir.Z * S - D2Z * T;
+			const float Reach = Radius[Index] + Swing.Radius;
+
+			if (DX * DX + DY * DY + DZ * DZ <= Reach * Reach)
+				OutHits.Add({ SwingIndex, Index });
+		}
+	}
+}
+
+void UABCombatHitTestSubsystem::Tick(float DeltaTime)
+{
+	if (Swings.Num() == 0)
+		return;
+
+	AB_SCOPE_CYCLE_COUNTER(STAT_ABCombatHitTest);
+	SET_DWORD_STAT(STAT_ABCombatHitTestSwings, Swings.Num());
+
+	BuildCombatants();
+
+	SwingHits.Reset();
+	Combatants.TestSwings(Swings, SwingHits);
+
+	const bool bValidate = CVarCombatValidateHitTest.GetValueOnGameThread() != 0;
+	int32 HitIndex = 0;
+
+	// Swings are resolved in the order they were queued; hits come out of the kernel grouped by swing.
+	TArray<FHitResult> HitResults;
+	for (int32 SwingIndex = 0; SwingIndex < Swings.Num(); ++SwingIndex)
+	{
+		const FABSwing& Swing = Swings[SwingIndex];
+		HitResults.Reset();
+
+		for (; HitIndex < SwingHits.Num() && SwingHits[HitIndex].Swing == SwingIndex; ++HitIndex)
+		{
+			AABCharacter* Target = CombatantCharacters[SwingHits[HitIndex].Combatant].Get();
+
+			// An earlier swing in this batch may already have killed it.
+			if (nullptr != Target && Target->GetActorEnableCollision())
+				HitResults.Emplace(Target, Target->GetCapsuleComponent(), Target->GetActorLocation(), (Swing.Start - Target->GetActorLocation()).GetSafeNormal());
+		}
+
+		AABCharacter* Attacker = SwingAttackers[SwingIndex].Get();
+		if (nullptr == Attacker || Attacker->GetCharacterState() != ECharacterState::READY)
+			continue;
+
+		if (bValidate)
+			ValidateSwing(SwingIndex, HitResults);
+
+		Attacker->ResolveAttackCheck(HitResults, Swing.Start, Swing.End);
+	}
+
+	Swings.Reset();
+	SwingAttackers.Reset();
+}
+
+TStatId UABCombatHitTestSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UABCombatHitTestSubsystem, STATGROUP_ArenaBattle);
+}
+
+bool UABCombatHitTestSubsystem::IsEnabled()
+{
+	return CVarCombatAnalyticHitTest.GetValueOnGameThread() != 0;
+}
+
+void UABCombatHitTestSubsystem::QueueSwing(AABCharacter* Attacker, const FVector& Start, const FVector& End, float SwingRadius)
+{
+	ABCHECK(nullptr != Attacker);
+
+	Swings.Add({ Start, End, SwingRadius });
+	SwingAttackers.Add(Attacker);
+}
+
+void UABCombatHitTestSubsystem::MakeBenchmarkScenario(int32 NumCombatants, int32 NumSwings, FABCombatantBuffer& OutBuffer, TArray<FABSwing>& OutSwings)
+{
+	// Fixed seed and a 200m square arena, so runs compare like for like.
+	FRandomStream Random(1234);
+	const float ArenaExtent = 10000.0f;
+
+	OutBuffer.Reset();
+	for (int32 Index = 0; Index < NumCombatants; ++Index)
+		OutBuffer.Add(FVector(Random.FRandRange(-ArenaExtent, ArenaExtent), Random.FRandRange(-ArenaExtent, ArenaExtent), 88.0f), 42.0f, 88.0f);
+
+	OutSwings.Reset();
+	for (int32 Index = 0; Index < NumSwings; ++Index)
+	{
+		const FVector Start(Random.FRandRange(-ArenaExtent, ArenaExtent), Random.FRandRange(-ArenaExtent, ArenaExtent), 88.0f);
+		const float   Yaw = Random.FRandRange(0.0f, 360.0f);
+		OutSwings.Add({ Start, Start + FRotator(0.0f, Yaw, 0.0f).Vector() * 200.0f, 50.0f });
+	}
+}
+
+void UABCombatHitTestSubsystem::RunBenchmark(int32 NumCombatants, int32 NumSwings, int32 Iterations)
+{
+	ABCHECK(NumCombatants > 0 && NumSwings > 0 && Iterations > 0);
+
+	FABCombatantBuffer Buffer;
+	TArray<FABSwing>   BenchSwings;
+	MakeBenchmarkScenario(NumCombatants, NumSwings, Buffer, BenchSwings);
+
+	TArray<FABSwingHit> VectorHits;
+	TArray<FABSwingHit> ScalarHits;
+
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		VectorHits.Reset();
+		Buffer.TestSwings(BenchSwings, VectorHits);
+	}
+	const double VectorSeconds = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		ScalarHits.Reset();
+		Buffer.TestSwingsScalar(BenchSwings, ScalarHits);
+	}
+	const double ScalarSeconds = FPlatformTime::Seconds() - StartTime;
+
+	ABLOG(Warning, TEXT("%d combatants x %d swings : vector %.2f us, scalar %.2f us per batch (%.1fx), %d hits"),
+		NumCombatants, NumSwings, VectorSeconds * 1e6 / Iterations, ScalarSeconds * 1e6 / Iterations,
+		VectorSeconds > 0.0 ? ScalarSeconds / VectorSeconds : 0.0, VectorHits.Num());
+}
+
+bool UABCombatHitTestSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UABCombatHitTestSubsystem::BuildCombatants()
+{
+	Combatants.Reset();
+	CombatantCharacters.Reset();
+
+	auto Perception = GetWorld()->GetSubsystem<UABPerceptionSubsystem>();
+	ABCHECK(nullptr != Perception);
+
+	// Characters without collision (dead, pooled, still loading) do not block the Attack channel either.
+	for (const TWeakObjectPtr<AABCharacter>& CharacterPtr : Perception->GetRegisteredCharacters())
+	{
+		AABCharacter* Character = CharacterPtr.Get();
+		if (nullptr == Character || !Character->GetActorEnableCollision())
+			continue;
+
+		const UCapsuleComponent* Capsule = Character->GetCapsuleComponent();
+		Combatants.Add(Capsule->GetComponentLocation(), Capsule->GetScaledCapsuleRadius(), Capsule->GetScaledCapsuleHalfHeight());
+		CombatantCharacters.Add(Character);
+	}
+
+	SET_DWORD_STAT(STAT_ABCombatHitTestCombatants, Combatants.Num());
+}
+
+void UABCombatHitTestSubsystem::ValidateSwing(int32 SwingIndex, const TArray<FHitResult>& HitResults) const
+{
+	const FABSwing& Swing    = Swings[SwingIndex];
+	AABCharacter*   Attacker = SwingAttackers[SwingIndex].Get();
+
+	FCollisionQueryParams Params(NAME_None, false, Attacker);
+	FCollisionResponseParams ResponseParams;
+	ResponseParams.CollisionResponse.SetAllChannels(ECR_Overlap);
+
+	TArray<FHitResult> PhysicsHits;
+	GetWorld()->SweepMultiByChannel(PhysicsHits, Swing.Start, Swing.End, FQuat::Identity, ECollisionChannel::ECC_GameTraceChannel2,
+		FCollisionShape::MakeSphere(Swing.Radius), Params, ResponseParams);
+
+	TSet<AActor*> AnalyticActors;
+	for (const FHitResult& Hit : HitResults)
+	{
+		if (Hit.GetActor() != Attacker)
+			AnalyticActors.Add(Hit.GetActor());
+	}
+
+	TSet<AActor*> PhysicsActors;
+	for (const FHitResult& Hit : PhysicsHits)
+		PhysicsActors.Add(Hit.GetActor());
+
+	for (AActor* Actor : AnalyticActors.Difference(PhysicsActors))
+	{
+		INC_DWORD_STAT(STAT_ABCombatHitTestMismatches);
+		ABLOG(Warning, TEXT("%s hit %s analytically but not through physics"), *GetNameSafe(Attacker), *GetNameSafe(Actor));
+	}
+
+	for (AActor* Actor : PhysicsActors.Difference(AnalyticActors))
+	{
+		INC_DWORD_STAT(STAT_ABCombatHitTestMismatches);
+		ABLOG(Warning, TEXT("%s hit %s through physics but not analytically"), *GetNameSafe(Attacker), *GetNameSafe(Actor));
+	}
+}
@@ -0,0 +1,116 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ABDetectScheduler.h"
+#include "BTService_Detect.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+#include "AIController.h"
+
+DECLARE_CYCLE_STAT(TEXT("Detect Scheduler"), STAT_ABDetectScheduler, STATGROUP_ArenaBattle);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Detect Requests Processed"), STAT_ABDetectProcessed, STATGROUP_ArenaBattle);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Detect Requests Deferred"), STAT_ABDetectDeferred, STATGROUP_ArenaBattle);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Detect Budget Used (us)"), STAT_ABDetectBudgetUsed, STATGROUP_ArenaBattle);
+
+static TAutoConsoleVariable<float> CVarDetectFrameBudget
+(
+	TEXT("ab.Detect.FrameBudgetUs"),
+	200.0f,
+	TEXT("Game thread time in microseconds the detection scheduler may spend per frame.\n")
+	TEXT("At least one request is processed every frame. 0 disables scheduling and detects immediately."),
+	ECVF_Default
+);
+
+void UABDetectScheduler::Tick(float DeltaTime)
+{
+	AB_SCOPE_CYCLE_COUNTER(STAT_ABDetectScheduler);
+
+	if (PendingRequests.Num() == 0)
+		return;
+
+	UpdatePriorities();
+	PendingRequests.Sort([](const FDetectRequest& A, const FDetectRequest& B) { return A.Priority < B.Priority; });
+
+	const double BudgetSeconds = CVarDetectFrameBudget.GetValueOnGameThread() * 1e-6;
+	const double StartTime     = FPlatformTime::Seconds();
+	int32 Processed = 0;
+
+	while (Processed < PendingRequests.Num())
+	{
+		if (Processed > 0 && FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+			break;
+
+		FDetectRequest& Request = PendingRequests[Processed++];
+		UBehaviorTreeComponent* OwnerComp = Request.OwnerComp.Get();
+		if (nullptr != OwnerComp && OwnerComp->IsRunning())
+			UBTService_Detect::DetectTarget(*OwnerComp, Request.DetectRadius);
+	}
+
+	PendingRequests.RemoveAt(0, Processed, false);
+	for (FDetectRequest& Request : PendingRequests)
+		Request.FramesWaiting++;
+
+	INC_DWORD_STAT_BY(STAT_ABDetectProcessed, Processed);
+	INC_DWORD_STAT_BY(STAT_ABDetectDeferred, PendingRequests.Num());
+	INC_FLOAT_STAT_BY(STAT_ABDetectBudgetUsed, (FPlatformTime::Seconds() - StartTime) * 1e6);
+}
+
+TStatId UABDetectScheduler::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UABDetectScheduler, STATGROUP_ArenaBattle);
+}
+
+bool UABDetectScheduler::IsEnabled()
+{
+	return CVarDetectFrameBudget.GetValueOnGameThread() > 0.0f;
+}
+
+void UABDetectScheduler::RequestDetect(UBehaviorTreeComponent& OwnerComp, float DetectRadius)
+{
+	for (const FDetectRequest& Request : PendingRequests)
+	{
+		if (Request.OwnerComp.Get() == &OwnerComp)
+			return;
+	}
+
+	FDetectRequest NewRequest;
+	NewRequest.OwnerComp    = &OwnerComp;
+	NewRequest.DetectRadius = DetectRadius;
+	PendingRequests.Add(NewRequest);
+}
+
+bool UABDetectScheduler::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UABDetectScheduler::UpdatePriorities()
+{
+	TArray<FVector, TInlineAllocator<4>> PlayerLocations;
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APawn* PlayerPawn = It->Get()->GetPawn();
+		if (nullptr != PlayerPawn)
+			PlayerLocations.Add(PlayerPawn->GetActorLocation());
+	}
+
+	for (FDetectRequest& Request : PendingRequests)
+	{
+		const UBehaviorTreeComponent* OwnerComp = Request.OwnerComp.Get();
+		const AAIController* AIOwner = (nullptr != OwnerComp) ? OwnerComp->GetAIOwner() : nullptr;
+		const APawn* Pawn = (nullptr != AIOwner) ? AIOwner->GetPawn() : nullptr;
+
+		// Stale requests go first so they are dropped from the queue without spending budget.
+		if (nullptr == Pawn)
+		{
+			Request.Priority = -1.0f;
+			continue;
+		}
+
+		float NearestDistSq = BIG_NUMBER;
+		for (const FVector& PlayerLocation : PlayerLocations)
+			NearestDistSq = FMath::Min(NearestDistSq, FVector::DistSquared(PlayerLocation, Pawn->GetActorLocation()));
+
+		// Every deferred frame shrinks the effective distance, so far NPCs cannot starve.
+		Request.Priority = NearestDistSq / FMath::Square(1.0f + Request.FramesWaiting);
+	}
+}
@@ -0,0 +1,97 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ABHPBarOverlayWidget.h"
+#include "ABCharacter.h"
+#include "ABCharacterStatComponent.h"
+#include "ABPerceptionSubsystem.h"
+#include "Blueprint/WidgetLayoutLibrary.h"
+#include "Styling/CoreStyle.h"
+
+DECLARE_CYCLE_STAT(TEXT("HP Bar Overlay Gather"), STAT_ABHPBarGather, STATGROUP_ArenaBattle);
+DECLARE_CYCLE_STAT(TEXT("HP Bar Overlay Paint"), STAT_ABHPBarPaint, STATGROUP_ArenaBattle);
+DECLARE_DWORD_COUNTER_STAT(TEXT("HP Bars Drawn"), STAT_ABHPBarsDrawn, STATGROUP_ArenaBattle);
+DECLARE_DWORD_COUNTER_STAT(TEXT("HP Bars Culled"), STAT_ABHPBarsCulled, STATGROUP_ArenaBattle);
+
+// Matches where the UI_HPBar component sat : 180 above a mesh that is offset 88 below the capsule center.
+static const FVector HPBarOffset(0.0f, 0.0f, 92.0f);
+
+void UABHPBarOverlayWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+{
+	Super::NativeTick(MyGeometry, InDeltaTime);
+
+	AB_SCOPE_CYCLE_COUNTER(STAT_ABHPBarGather);
+	Bars.Reset();
+
+	APlayerController* PlayerController = GetOwningPlayer();
+	auto Perception = GetWorld()->GetSubsystem<UABPerceptionSubsystem>();
+	if (nullptr == PlayerController || nullptr == Perception || nullptr == PlayerController->PlayerCameraManager)
+		return;
+
+	const FVector ViewLocation = PlayerController->PlayerCameraManager->GetCameraLocation();
+
+	TArray<AABCharacter*> Characters;
+	Perception->QueryCharacters(ViewLocation, MaxDrawDistance, Characters);
+
+	int32 NumCulled = 0;
+	for (AABCharacter* Character : Characters)
+	{
+		if (Character->GetCharacterState() != ECharacterState::READY || !Character->WasRecentlyRendered(0.1f))
+		{
+			NumCulled++;
+			continue;
+		}
+
+		FHPBar Bar;
+		if (!UWidgetLayoutLibrary::ProjectWorldLocationToWidgetPosition(PlayerController, Character->GetActorLocation() + HPBarOffset, Bar.Position, false))
+		{
+			NumCulled++;
+			continue;
+		}
+
+		Bar.Ratio  = Character->CharacterStat->GetHPRatio();
+		Bar.DistSq = FVector::DistSquared(ViewLocation, Character->GetActorLocation());
+		Bars.Add(Bar);
+	}
+
+	if (Bars.Num() > MaxBars)
+	{
+		Bars.Sort([](const FHPBar& A, const FHPBar& B) { return A.DistSq < B.DistSq; });
+		NumCulled += Bars.Num() - MaxBars;
+		Bars.SetNum(MaxBars, false);
+	}
+
+	SET_DWORD_STAT(STAT_ABHPBarsCulled, NumCulled);
+}
+
+int32 UABHPBarOverlayWidget::NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+	FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	int32 MaxLayerId = Super::NativePaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+
+	AB_SCOPE_CYCLE_COUNTER(STAT_ABHPBarPaint);
+
+	const FSlateBrush* Brush = FCoreStyle::Get().GetBrush(TEXT("GenericWhiteBox"));
+	const FLinearColor BackColor(0.05f, 0.05f, 0.05f, 0.8f);
+	const FLinearColor FillColor(0.8f, 0.1f, 0.1f, 1.0f);
+
+	// Every background goes on one layer and every fill on the next, so Slate can batch each into a single draw.
+	const int32 BackLayer = MaxLayerId + 1;
+	const int32 FillLayer = MaxLayerId + 2;
+
+	for (const FHPBar& Bar : Bars)
+	{
+		const FVector2D TopLeft = Bar.Position - BarSize * 0.5f;
+
+		FSlateDrawElement::MakeBox(OutDrawElements, BackLayer,
+			AllottedGeometry.ToPaintGeometry(BarSize, FSlateLayoutTransform(TopLeft)), Brush, ESlateDrawEffect::None, BackColor);
+
+		FSlateDrawElement::MakeBox(OutDrawElements, FillLayer,
+			AllottedGeometry.ToPaintGeometry(FVector2D(BarSize.X * Bar.Ratio, BarSize.Y), FSlateLayoutTransform(TopLeft)), Brush,
+			ESlateDrawEffect::None, FillColor);
+	}
+
+	SET_DWORD_STAT(STAT_ABHPBarsDrawn, Bars.Num());
+
+	return Bars.Num() > 0 ? FillLayer : MaxLayerId;
+}
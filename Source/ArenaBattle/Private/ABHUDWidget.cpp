@@ -7,10 +7,17 @@
 #include "ABCharacterStatComponent.h"
 #include "ABPlayerState.h"
 
+DECLARE_CYCLE_STAT(TEXT("HUD Apply"), STAT_ABHUDApply, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("HUD Updates Requested"), STAT_ABHUDUpdatesRequested, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("HUD Updates Applied"), STAT_ABHUDUpdatesApplied, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("HUD Widget Invalidations (Unbatched)"), STAT_ABHUDInvalidationsUnbatched, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("HUD Widget Invalidations"), STAT_ABHUDInvalidations, STATGROUP_ArenaBattle);
+
 
 void UABHUDWidget::BindCharacterStat(UABCharacterStatComponent* CharacterStat)
 {
 	CurrentCharacterStat = CharacterStat;
+	CharacterStat->OnHPChanged.RemoveAll(this);
 	CharacterStat->OnHPChanged.AddUObject(this, &UABHUDWidget::UpdateCharacterStat);
 }
 
@@ -31,17 +38,91 @@ void UABHUDWidget::NativeConstruct()
 	HighScore    = Cast<UTextBlock>  (GetWidgetFromName(TEXT("txtHighScore")));
 }
 
+void UABHUDWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+{
+	Super::NativeTick(MyGeometry, InDeltaTime);
+
+	if (!bCharacterStatDirty && !bPlayerStateDirty)
+		return;
+
+	AB_SCOPE_CYCLE_COUNTER(STAT_ABHUDApply);
+
+	if (bCharacterStatDirty)
+		ApplyCharacterStat();
+
+	if (bPlayerStateDirty)
+		ApplyPlayerState();
+}
+
 void UABHUDWidget::UpdateCharacterStat()
 {
-		HPBar->SetPercent(CurrentCharacterStat->GetHPRatio());
+	bCharacterStatDirty = true;
 
+	INC_DWORD_STAT(STAT_ABHUDUpdatesRequested);
+	INC_DWORD_STAT(STAT_ABHUDInvalidationsUnbatched);
 }
 
 void UABHUDWidget::UpdatePlayerState()
 {
-	ExpBar      ->SetPercent(CurrentPlayerState->GetExpRatio());
-	PlayerName  ->SetText(FText::FromString(CurrentPlayerState->GetPlayerName()));
-	PlayerLevel ->SetText(FText::FromString(FString::FromInt(CurrentPlayerState->GetCharacterLevel())));
-	CurrentScore->SetText(FText::FromString(FString::FromInt(CurrentPlayerState->GetGameScore())));
-	HighScore   ->SetText(FText::FromString(FString::FromInt(CurrentPlayerState->GetGameHighScore())));
+	bPlayerStateDirty = true;
+
+	// The old path reset all five widgets on every broadcast.
+	INC_DWORD_STAT(STAT_ABHUDUpdatesRequested);
+	INC_DWORD_STAT_BY(STAT_ABHUDInvalidationsUnbatched, 5);
+}
+
+void UABHUDWidget::ApplyCharacterStat()
+{
+	bCharacterStatDirty = false;
+	if (!CurrentCharacterStat.IsValid())
+		return;
+
+	INC_DWORD_STAT(STAT_ABHUDUpdatesApplied);
+
+	const float HPRatio = CurrentCharacterStat->GetHPRatio();
+	if (HPRatio != CachedHPRatio)
+	{
+		CachedHPRatio = HPRatio;
+		HPBar->SetPercent(HPRatio);
+		INC_DWORD_STAT(STAT_ABHUDInvalidations);
+	}
+}
+
+void UABHUDWidget::ApplyPlayerState()
+{
+	bPlayerStateDirty = false;
+	if (!CurrentPlayerState.IsValid())
+		return;
+
+	INC_DWORD_STAT(STAT_ABHUDUpdatesApplied);
+
+	const float ExpRatio = CurrentPlayerState->GetExpRatio();
+	if (ExpRatio != CachedExpRatio)
+	{
+		CachedExpRatio = ExpRatio;
+		ExpBar->SetPercent(ExpRatio);
+		INC_DWORD_STAT(STAT_ABHUDInvalidations);
+	}
+
+	const FString& NewPlayerName = CurrentPlayerState->GetPlayerName();
+	if (!NewPlayerName.Equals(CachedPlayerName, ESearchCase::CaseSensitive))
+	{
+		CachedPlayerName = NewPlayerName;
+		PlayerName->SetText(FText::FromString(CachedPlayerName));
+		INC_DWORD_STAT(STAT_ABHUDInvalidations);
+	}
+
+	SetNumberText(PlayerLevel,  CurrentPlayerState->GetCharacterLevel(), CachedLevel);
+	SetNumberText(CurrentScore, CurrentPlayerState->GetGameScore(),      CachedScore);
+	SetNumberText(HighScore,    CurrentPlayerState->GetGameHighScore(),  CachedHighScore);
+}
+
+void UABHUDWidget::SetNumberText(UTextBlock* TextBlock, int32 Value, int32& CachedValue)
+{
+	if (Value == CachedValue)
+		return;
+
+	CachedValue = Value;
+	TextBlock->SetText(FText::AsNumber(Value, &FNumberFormattingOptions::DefaultNoGrouping()));
+	INC_DWORD_STAT(STAT_ABHUDInvalidations);
 }
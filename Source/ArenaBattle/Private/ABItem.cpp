@@ -4,6 +4,7 @@
 #include "ABItem.h"
 #include "ABCharacter.h"
 #include "ABWeapon.h"
+#include "ABItemPoolSubsystem.h"
 
 // Sets default values
 AABItem::AABItem()
@@ -13,11 +14,9 @@ AABItem::AABItem()
 
 	Trigger = CreateDefaultSubobject<UBoxComponent>(TEXT("TRIGGER"));
 	Box     = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("BOX"));
-	Effect  = CreateDefaultSubobject<UParticleSystemComponent>(TEXT("Effect"));
 	
 	RootComponent = Trigger;
 	Box   ->SetupAttachment(RootComponent);
-	Effect->SetupAttachment(RootComponent);
 
 	Trigger->SetBoxExtent(FVector(26.5f, 27.5f, 13.5f));
 	Trigger->SetRelativeScale3D(FVector(1.5f, 1.5f, 1.5f));
@@ -30,13 +29,9 @@ AABItem::AABItem()
 	static ConstructorHelpers::FObjectFinder < UParticleSystem> P_CHESTOPEN
 	(TEXT("/Game/InfinityBladeGrassLands/Effects/FX_Treasure/Chest/P_TreasureChest_Open_Mesh.P_TreasureChest_Open_Mesh"));
 	if (P_CHESTOPEN.Succeeded())
-	{
-		Effect->SetTemplate(P_CHESTOPEN.Object);
-		Effect->bAutoActivate = false;
-	}
+		OpenEffect = P_CHESTOPEN.Object;
 
 	Box->SetRelativeLocation(FVector(0.0f, -3.5f, -13.5f));
-	Effect->SetRelativeLocation(FVector(0.0f, 0.0f, -45.0f));
 
 	Trigger->SetCollisionProfileName(TEXT("ItemBox"));
 	Box    ->SetCollisionProfileName(TEXT("NoCollision"));
@@ -57,6 +52,20 @@ void AABItem::PostInitializeComponents()
 	Trigger->OnComponentBeginOverlap.AddDynamic(this, &AABItem::OnCharacterOverlap);
 }
 
+void AABItem::ActivateItem()
+{
+	SetActorHiddenInGame(false);
+	Box->SetHiddenInGame(false, true);
+	SetActorEnableCollision(true);
+}
+
+void AABItem::DeactivateItem()
+{
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	OnItemClaimed.Clear();
+}
+
 void AABItem::OnCharacterOverlap(UPrimitiveComponent* OVerlappedComp, AActor* OtherActor, 
 	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
@@ -65,18 +74,18 @@ void AABItem::OnCharacterOverlap(UPrimitiveComponent* OVerlappedComp, AActor* Ot
 	{
 		if (ABCharacter->CanSetWeapon())
 		{
-			auto NewWeapon = GetWorld()->SpawnActor<AABWeapon>(WeaponItemClass, FVector::ZeroVector, FRotator::ZeroRotator);
-			ABCharacter->SetWeapon(NewWeapon);
-			Effect->Activate(true);
-			Box->SetHiddenInGame(true, true);
-			SetActorEnableCollision(false);
-			Effect->OnSystemFinished.AddDynamic(this, &AABItem::OnEffectFinished);
+			ABCharacter->EquipWeapon(WeaponItemClass);
+			OnItemClaimed.Broadcast();
+
+			auto ItemPool = GetWorld()->GetSubsystem<UABItemPoolSubsystem>();
+			if (nullptr != ItemPool)
+			{
+				ItemPool->PlayEffect(OpenEffect, FTransform(FVector(0.0f, 0.0f, -45.0f)) * GetActorTransform());
+				ItemPool->ReleaseItem(this);
+			}
+			else
+				Destroy();
 		}
 	}
 }
 
-void AABItem::OnEffectFinished(UParticleSystemComponent* PSystem)
-{
-	Destroy();
-}
-
@@ -0,0 +1,138 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ABItemPoolSubsystem.h"
+#include "ABItem.h"
+#include "Particles/ParticleSystemComponent.h"
+
+DECLARE_CYCLE_STAT(TEXT("Item Pool Acquire"), STAT_ABItemPoolAcquire, STATGROUP_ArenaBattle);
+DECLARE_CYCLE_STAT(TEXT("Item Pool Play Effect"), STAT_ABItemPoolPlayEffect, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Item Actors Spawned"), STAT_ABItemActorsSpawned, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Item Actors Live"), STAT_ABItemActorsLive, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Item Actors Pooled"), STAT_ABItemActorsPooled, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Item Effect Components Created"), STAT_ABItemEffectsCreated, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Item Effect Components Live"), STAT_ABItemEffectsLive, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Item Effect Components Pooled"), STAT_ABItemEffectsPooled, STATGROUP_ArenaBattle);
+
+void UABItemPoolSubsystem::Deinitialize()
+{
+	AvailableItems.Reset();
+	AvailableEffects.Reset();
+	LiveItemCount   = 0;
+	LiveEffectCount = 0;
+	UpdateStats();
+
+	Super::Deinitialize();
+}
+
+AABItem* UABItemPoolSubsystem::AcquireItem(const FVector& Location, const FRotator& Rotation)
+{
+	AB_SCOPE_CYCLE_COUNTER(STAT_ABItemPoolAcquire);
+
+	AABItem* Item = nullptr;
+	while (nullptr == Item && AvailableItems.Num() > 0)
+	{
+		Item = AvailableItems.Pop(false);
+		if (!IsValid(Item))
+			Item = nullptr;
+	}
+
+	if (nullptr != Item)
+	{
+		Item->SetActorLocationAndRotation(Location, Rotation);
+		Item->ActivateItem();
+	}
+	else
+	{
+		Item = GetWorld()->SpawnActor<AABItem>(Location, Rotation);
+		if (nullptr == Item)
+			return nullptr;
+
+		INC_DWORD_STAT(STAT_ABItemActorsSpawned);
+	}
+
+	LiveItemCount++;
+	UpdateStats();
+
+	return Item;
+}
+
+void UABItemPoolSubsystem::ReleaseItem(AABItem* Item)
+{
+	ABCHECK(nullptr != Item);
+
+	// Items placed in the level never went through AcquireItem.
+	LiveItemCount = FMath::Max(LiveItemCount - 1, 0);
+
+	if (AvailableItems.Num() >= MaxPooledItems)
+		Item->Destroy();
+	else
+	{
+		Item->DeactivateItem();
+		AvailableItems.Add(Item);
+	}
+
+	UpdateStats();
+}
+
+void UABItemPoolSubsystem::PlayEffect(UParticleSystem* Template, const FTransform& Transform)
+{
+	AB_SCOPE_CYCLE_COUNTER(STAT_ABItemPoolPlayEffect);
+
+	if (nullptr == Template)
+		return;
+
+	UParticleSystemComponent* Effect = nullptr;
+	while (nullptr == Effect && AvailableEffects.Num() > 0)
+	{
+		Effect = AvailableEffects.Pop(false);
+		if (!IsValid(Effect))
+			Effect = nullptr;
+	}
+
+	if (nullptr == Effect)
+	{
+		Effect = NewObject<UParticleSystemComponent>(GetWorld()->GetWorldSettings());
+		Effect->bAutoActivate = false;
+		Effect->bAutoDestroy  = false;
+		Effect->SetUsingAbsoluteLocation(true);
+		Effect->SetUsingAbsoluteRotation(true);
+		Effect->SetUsingAbsoluteScale(true);
+		Effect->OnSystemFinished.AddDynamic(this, &UABItemPoolSubsystem::OnEffectFinished);
+		Effect->RegisterComponentWithWorld(GetWorld());
+
+		INC_DWORD_STAT(STAT_ABItemEffectsCreated);
+	}
+
+	Effect->SetTemplate(Template);
+	Effect->SetWorldTransform(Transform);
+	Effect->Activate(true);
+
+	LiveEffectCount++;
+	UpdateStats();
+}
+
+bool UABItemPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UABItemPoolSubsystem::OnEffectFinished(UParticleSystemComponent* PSystem)
+{
+	LiveEffectCount = FMath::Max(LiveEffectCount - 1, 0);
+
+	if (AvailableEffects.Num() >= MaxPooledEffects)
+		PSystem->DestroyComponent();
+	else
+		AvailableEffects.Add(PSystem);
+
+	UpdateStats();
+}
+
+void UABItemPoolSubsystem::UpdateStats()
+{
+	SET_DWORD_STAT(STAT_ABItemActorsLive, LiveItemCount);
+	SET_DWORD_STAT(STAT_ABItemActorsPooled, AvailableItems.Num());
+	SET_DWORD_STAT(STAT_ABItemEffectsLive, LiveEffectCount);
+	SET_DWORD_STAT(STAT_ABItemEffectsPooled, AvailableEffects.Num());
+}
@@ -0,0 +1,170 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ABPerceptionSubsystem.h"
+#include "ABCharacter.h"
+
+DECLARE_CYCLE_STAT(TEXT("Perception Hash Rebuild"), STAT_ABPerceptionRebuild, STATGROUP_ArenaBattle);
+DECLARE_CYCLE_STAT(TEXT("Perception Hash Query"), STAT_ABPerceptionQuery, STATGROUP_ArenaBattle);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Perception Hash Characters"), STAT_ABPerceptionCharacters, STATGROUP_ArenaBattle);
+DECLARE_MEMORY_STAT(TEXT("Perception Hash Memory"), STAT_ABPerceptionMemory, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Detect Queries/s (Spatial Hash)"), STAT_ABPerceptionHashQueriesPerSec, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Detect Queries/s (Physics Overlap)"), STAT_ABPerceptionPhysicsQueriesPerSec, STATGROUP_ArenaBattle);
+
+template<typename FunctorType>
+void UABPerceptionSubsystem::ForEachInRadius(const FVector& Center, float Radius, FunctorType&& Functor) const
+{
+	AB_SCOPE_CYCLE_COUNTER(STAT_ABPerceptionQuery);
+	HashQueryCount++;
+
+	const FIntPoint MinCell  = GetCellCoord(Center - FVector(Radius, Radius, 0.0f));
+	const FIntPoint MaxCell  = GetCellCoord(Center + FVector(Radius, Radius, 0.0f));
+	const float     RadiusSq = FMath::Square(Radius);
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			const FCellSpan* Span = Cells.Find(FIntPoint(X, Y));
+			if (nullptr == Span)
+				continue;
+
+			for (int32 Index = Span->Start; Index < Span->Start + Span->Num; ++Index)
+			{
+				const FCellEntry& Entry = Entries[Index];
+				const float DistSq = FVector::DistSquared(Center, Entry.Location);
+				if (DistSq > RadiusSq)
+					continue;
+
+				AABCharacter* Character = Entry.Character.Get();
+				if (nullptr != Character)
+					Functor(Character, DistSq);
+			}
+		}
+	}
+}
+
+void UABPerceptionSubsystem::Tick(float DeltaTime)
+{
+	RebuildHash();
+	UpdateQueryRates(DeltaTime);
+}
+
+TStatId UABPerceptionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UABPerceptionSubsystem, STATGROUP_ArenaBattle);
+}
+
+void UABPerceptionSubsystem::RegisterCharacter(AABCharacter* Character)
+{
+	ABCHECK(nullptr != Character);
+	Characters.AddUnique(Character);
+}
+
+void UABPerceptionSubsystem::UnregisterCharacter(AABCharacter* Character)
+{
+	Characters.RemoveSwap(Character);
+}
+
+AABCharacter* UABPerceptionSubsystem::FindPlayerInRadius(const FVector& Center, float Radius, const AActor* IgnoreActor) const
+{
+	AABCharacter* Result = nullptr;
+	float NearestDistSq  = FMath::Square(Radius);
+
+	ForEachInRadius(Center, Radius, [&](AABCharacter* Character, float DistSq)
+	{
+		if (Character == IgnoreActor || DistSq > NearestDistSq)
+			return;
+
+		if (nullptr != Character->GetController() && Character->GetController()->IsPlayerController())
+		{
+			Result        = Character;
+			NearestDistSq = DistSq;
+		}
+	});
+
+	return Result;
+}
+
+void UABPerceptionSubsystem::QueryCharacters(const FVector& Center, float Radius, TArray<AABCharacter*>& OutCharacters) const
+{
+	ForEachInRadius(Center, Radius, [&OutCharacters](AABCharacter* Character, float DistSq)
+	{
+		OutCharacters.Add(Character);
+	});
+}
+
+const TArray<TWeakObjectPtr<AABCharacter>>& UABPerceptionSubsystem::GetRegisteredCharacters() const
+{
+	return Characters;
+}
+
+void UABPerceptionSubsystem::NotifyPhysicsQuery()
+{
+	PhysicsQueryCount++;
+}
+
+bool UABPerceptionSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+FIntPoint UABPerceptionSubsystem::GetCellCoord(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+void UABPerceptionSubsystem::RebuildHash()
+{
+	AB_SCOPE_CYCLE_COUNTER(STAT_ABPerceptionRebuild);
+
+	Entries.Reset();
+	Cells.Reset();
+
+	for (int32 Index = Characters.Num() - 1; Index >= 0; --Index)
+	{
+		AABCharacter* Character = Characters[Index].Get();
+		if (nullptr == Character)
+		{
+			Characters.RemoveAtSwap(Index);
+			continue;
+		}
+
+		// Characters without collision (dead, not yet spawned in) were invisible to the old overlap query as well.
+		if (!Character->GetActorEnableCollision())
+			continue;
+
+		const FVector Location = Character->GetActorLocation();
+		Entries.Add({ GetCellCoord(Location), Location, Character });
+	}
+
+	Entries.Sort([](const FCellEntry& A, const FCellEntry& B)
+	{
+		return (A.Cell.X != B.Cell.X) ? (A.Cell.X < B.Cell.X) : (A.Cell.Y < B.Cell.Y);
+	});
+
+	for (int32 Index = 0; Index < Entries.Num(); ++Index)
+	{
+		FCellSpan& Span = Cells.FindOrAdd(Entries[Index].Cell);
+		if (Span.Num == 0)
+			Span.Start = Index;
+		Span.Num++;
+	}
+
+	SET_DWORD_STAT(STAT_ABPerceptionCharacters, Entries.Num());
+	SET_MEMORY_STAT(STAT_ABPerceptionMemory, Characters.GetAllocatedSize() + Entries.GetAllocatedSize() + Cells.GetAllocatedSize());
+}
+
+void UABPerceptionSubsystem::UpdateQueryRates(float DeltaTime)
+{
+	QueryRateTime += DeltaTime;
+	if (QueryRateTime < 1.0f)
+		return;
+
+	SET_DWORD_STAT(STAT_ABPerceptionHashQueriesPerSec, FMath::RoundToInt(HashQueryCount / QueryRateTime));
+	SET_DWORD_STAT(STAT_ABPerceptionPhysicsQueriesPerSec, FMath::RoundToInt(PhysicsQueryCount / QueryRateTime));
+
+	HashQueryCount    = 0;
+	PhysicsQueryCount = 0;
+	QueryRateTime     = 0.0f;
+}
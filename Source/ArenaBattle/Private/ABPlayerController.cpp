@@ -8,6 +8,8 @@
 #include "ABGameplayWidget.h"
 #include "ABGameplayResultWidget.h"
 #include "ABGameState.h"
+#include "ABHPBarOverlayWidget.h"
+#include "ABCharacterSetting.h"
 
 AABPlayerController::AABPlayerController()
 {
@@ -83,6 +85,13 @@ void AABPlayerController::BeginPlay()
 	HUDWidget = CreateWidget<UABHUDWidget>(this, HUDWidgetClass);
 	HUDWidget->AddToViewport(1);
 
+	if (!GetDefault<UABCharacterSetting>()->bUseHPBarWidgetComponent)
+	{
+		HPBarOverlayWidget = CreateWidget<UABHPBarOverlayWidget>(this, UABHPBarOverlayWidget::StaticClass());
+		HPBarOverlayWidget->SetVisibility(ESlateVisibility::HitTestInvisible);
+		HPBarOverlayWidget->AddToViewport(0);
+	}
+
 	ResultWidget = CreateWidget<UABGameplayResultWidget>(this, ResultWidgetClass);
 
 	ABPlayerState = Cast<AABPlayerState>(PlayerState);
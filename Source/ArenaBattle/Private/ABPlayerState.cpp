@@ -3,7 +3,7 @@
 
 #include "ABPlayerState.h"
 #include "ABGameInstance.h"
-#include "ABSaveGame.h"
+#include "ABSaveService.h"
 
 AABPlayerState::AABPlayerState()
 {
@@ -37,7 +37,7 @@ int32 AABPlayerState::GetCharacterIndex() const
 
 float AABPlayerState::GetExpRatio() const
 {
-	if(CurrentStatData->NextExp <= KINDA_SMALL_NUMBER)
+	if(nullptr == CurrentStatData || CurrentStatData->NextExp <= KINDA_SMALL_NUMBER)
 		return 0.0f;
 
 	float Result = (float)Exp / (float)CurrentStatData->NextExp;
@@ -47,7 +47,7 @@ float AABPlayerState::GetExpRatio() const
 
 bool AABPlayerState::AddExp(int32 IncomeExp)
 {
-	if (CurrentStatData->NextExp == -1)
+	if (nullptr == CurrentStatData || CurrentStatData->NextExp == -1)
 		return false;
 
 	bool DidLevelUp = false;
@@ -69,37 +69,66 @@ void AABPlayerState::AddGameScore()
 {
 	GameScore++;
 	if (GameScore >= GameHighScore)
+	{
 		GameHighScore = GameScore;
+
+		auto SaveService = GetGameInstance()->GetSubsystem<UABSaveService>();
+		SaveService->SubmitHighScore(SaveSlotName, GetPlayerName(), GameHighScore);
+	}
 	OnPlayerStateChanged.Broadcast();
 	SavePlayerData();
 }
 
 void AABPlayerState::InitPlayerData()
 {
-	auto ABSaveGame = Cast<UABSaveGame>(UGameplayStatics::LoadGameFromSlot(SaveSlotName, 0));
-	if (nullptr == ABSaveGame)
-		ABSaveGame = GetMutableDefault<UABSaveGame>();
+	auto SaveService = GetGameInstance()->GetSubsystem<UABSaveService>();
+	SaveSlotName     = SaveService->GetActiveSlot();
+
+	bPlayerDataLoaded = false;
+	SaveService->LoadProfileAsync(SaveSlotName, FOnProfileLoadedDelegate::CreateUObject(this, &AABPlayerState::ApplyLoadedPlayerData));
+}
 
-	SetPlayerName(ABSaveGame->PlayerName);
-	SetCharacterLevel(ABSaveGame->Level);
+bool AABPlayerState::IsPlayerDataLoaded() const
+{
+	return bPlayerDataLoaded;
+}
+
+void AABPlayerState::ApplyLoadedPlayerData(const FABProfileData& Data)
+{
+	SetPlayerName(Data.PlayerName);
+	SetCharacterLevel(Data.Level);
 	GameScore      = 0;
-	GameHighScore  = ABSaveGame->HighScore;
-	Exp			   = ABSaveGame->Exp;
-	CharacterIndex = ABSaveGame->CharacterIndex;
+	GameHighScore  = Data.HighScore;
+	Exp			   = Data.Exp;
+	CharacterIndex = Data.CharacterIndex;
 
-	SavePlayerData();
+	bPlayerDataLoaded = true;
+	OnPlayerDataReady.Broadcast();
+	OnPlayerStateChanged.Broadcast();
 }
 
 void AABPlayerState::SavePlayerData()
 {
-	UABSaveGame* NewPlayerData    = NewObject<UABSaveGame>();
-	NewPlayerData->PlayerName     = GetPlayerName();
-	NewPlayerData->Level	      = CharacterLevel;
-	NewPlayerData->Exp		      = Exp;
-	NewPlayerData->HighScore      = GameHighScore;
-	NewPlayerData->CharacterIndex = CharacterIndex;
-
-	UGameplayStatics::SaveGameToSlot(NewPlayerData, SaveSlotName, 0);
+	auto SaveService = GetGameInstance()->GetSubsystem<UABSaveService>();
+	SaveService->MarkDirty(this);
+}
+
+void AABPlayerState::WritePlayerData(FABProfileData& OutData) const
+{
+	OutData.PlayerName     = GetPlayerName();
+	OutData.Level          = CharacterLevel;
+	OutData.Exp            = Exp;
+	OutData.HighScore      = GameHighScore;
+	OutData.CharacterIndex = CharacterIndex;
+}
+
+void AABPlayerState::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	auto SaveService = GetGameInstance()->GetSubsystem<UABSaveService>();
+	if (nullptr != SaveService)
+		SaveService->Flush();
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AABPlayerState::SetCharacterLevel(int32 NewCharacterLevel)
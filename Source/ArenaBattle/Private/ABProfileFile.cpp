@@ -0,0 +1,125 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ABProfileFile.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+
+FString FABProfileFile::GetProfilePath(const FString& SlotName)
+{
+	return FPaths::ProjectSavedDir() / TEXT("SaveGames") / SlotName + TEXT(".abprofile");
+}
+
+bool FABProfileFile::Parse(const TArray<uint8>& Bytes, FABProfileData& OutData, int32& OutNumRecords, bool& bOutTornTail)
+{
+	OutNumRecords = 0;
+	bOutTornTail  = false;
+
+	if (Bytes.Num() < HeaderSize)
+		return false;
+
+	FMemoryReader Reader(Bytes);
+
+	uint32 FileMagic   = 0;
+	uint16 FileVersion = 0;
+	uint16 Reserved    = 0;
+	uint32 BodySize    = 0;
+	uint32 BodyCrc     = 0;
+	Reader << FileMagic << FileVersion << Reserved << BodySize << BodyCrc;
+
+	if (FileMagic != Magic || FileVersion > Version || (int64)HeaderSize + BodySize > Bytes.Num())
+		return false;
+
+	if (FCrc::MemCrc32(Bytes.GetData() + HeaderSize, BodySize) != BodyCrc)
+		return false;
+
+	FABProfileData Data;
+	Reader << Data.Level << Data.Exp << Data.HighScore << Data.CharacterIndex << Data.PlayerName;
+	if (Reader.IsError())
+		return false;
+
+	Reader.Seek(HeaderSize + BodySize);
+	while (Reader.Tell() + RecordSize <= Bytes.Num())
+	{
+		const uint8* Payload = Bytes.GetData() + Reader.Tell();
+
+		uint8  Type  = 0;
+		int32  Value = 0;
+		uint32 Crc   = 0;
+		Reader << Type << Value << Crc;
+
+		if (FCrc::MemCrc32(Payload, PayloadSize) != Crc)
+			break;
+
+		switch ((ERecordType)Type)
+		{
+		case ERecordType::LEVEL:          Data.Level          = Value; break;
+		case ERecordType::EXP:            Data.Exp            = Value; break;
+		case ERecordType::HIGHSCORE:      Data.HighScore      = Value; break;
+		case ERecordType::CHARACTERINDEX: Data.CharacterIndex = Value; break;
+		default:
+			ABLOG(Warning, TEXT("Unknown profile record %d skipped."), Type);
+			break;
+		}
+
+		OutNumRecords++;
+	}
+
+	bOutTornTail = (Reader.Tell() != Bytes.Num());
+	OutData      = MoveTemp(Data);
+	return true;
+}
+
+void FABProfileFile::WriteSnapshot(const FABProfileData& Data, TArray<uint8>& OutBytes)
+{
+	FABProfileData Body = Data;
+
+	TArray<uint8> BodyBytes;
+	FMemoryWriter BodyWriter(BodyBytes);
+	BodyWriter << Body.Level << Body.Exp << Body.HighScore << Body.CharacterIndex << Body.PlayerName;
+
+	uint32 FileMagic   = Magic;
+	uint16 FileVersion = Version;
+	uint16 Reserved    = 0;
+	uint32 BodySize    = BodyBytes.Num();
+	uint32 BodyCrc     = FCrc::MemCrc32(BodyBytes.GetData(), BodyBytes.Num());
+
+	OutBytes.Reset(HeaderSize + BodyBytes.Num());
+	FMemoryWriter Writer(OutBytes);
+	Writer << FileMagic << FileVersion << Reserved << BodySize << BodyCrc;
+	Writer.Serialize(BodyBytes.GetData(), BodyBytes.Num());
+}
+
+bool FABProfileFile::WriteJournal(const FABProfileData& From, const FABProfileData& To, TArray<uint8>& OutBytes, int32& OutNumRecords)
+{
+	if (From.PlayerName != To.PlayerName)
+		return false;
+
+	OutBytes.Reset();
+
+	if (From.Level != To.Level)
+		WriteRecord(ERecordType::LEVEL, To.Level, OutBytes);
+	if (From.Exp != To.Exp)
+		WriteRecord(ERecordType::EXP, To.Exp, OutBytes);
+	if (From.HighScore != To.HighScore)
+		WriteRecord(ERecordType::HIGHSCORE, To.HighScore, OutBytes);
+	if (From.CharacterIndex != To.CharacterIndex)
+		WriteRecord(ERecordType::CHARACTERINDEX, To.CharacterIndex, OutBytes);
+
+	OutNumRecords = OutBytes.Num() / RecordSize;
+	return true;
+}
+
+void FABProfileFile::WriteRecord(ERecordType Type, int32 Value, TArray<uint8>& OutBytes)
+{
+	const int32 Start = OutBytes.Num();
+
+	FMemoryWriter Writer(OutBytes);
+	Writer.Seek(Start);
+
+	uint8 RecordType = (uint8)Type;
+	Writer << RecordType << Value;
+
+	uint32 Crc = FCrc::MemCrc32(OutBytes.GetData() + Start, PayloadSize);
+	Writer << Crc;
+}
@@ -0,0 +1,154 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ABProfileIndex.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+
+struct FLeaderboardMinScore
+{
+	bool operator()(const FABLeaderboardEntry& A, const FABLeaderboardEntry& B) const
+	{
+		return A.Score < B.Score;
+	}
+};
+
+FString FABProfileIndex::GetIndexPath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("SaveGames") / TEXT("ProfileIndex.abindex");
+}
+
+bool FABProfileIndex::Parse(const TArray<uint8>& Bytes)
+{
+	FMemoryReader Reader(Bytes);
+
+	uint32 FileMagic   = 0;
+	uint16 FileVersion = 0;
+	uint32 BodyCrc     = 0;
+	Reader << FileMagic << FileVersion << BodyCrc;
+
+	const int64 BodyOffset = Reader.Tell();
+	if (Reader.IsError() || FileMagic != Magic || FileVersion > Version
+		|| FCrc::MemCrc32(Bytes.GetData() + BodyOffset, Bytes.Num() - BodyOffset) != BodyCrc)
+		return false;
+
+	int32 NumProfiles = 0;
+	Reader << NumProfiles;
+
+	TMap<FString, FABProfileSummary> NewProfiles;
+	NewProfiles.Reserve(NumProfiles);
+	for (int32 Index = 0; Index < NumProfiles && !Reader.IsError(); ++Index)
+	{
+		FString SlotName;
+		FABProfileSummary Summary;
+		Reader << SlotName << Summary.PlayerName << Summary.Level << Summary.HighScore << Summary.CharacterIndex;
+		NewProfiles.Add(MoveTemp(SlotName), MoveTemp(Summary));
+	}
+
+	int32 NumEntries = 0;
+	Reader << NumEntries;
+
+	TArray<FABLeaderboardEntry> NewLeaderboard;
+	NewLeaderboard.Reserve(NumEntries);
+	for (int32 Index = 0; Index < NumEntries && !Reader.IsError(); ++Index)
+	{
+		FABLeaderboardEntry& Entry = NewLeaderboard.AddDefaulted_GetRef();
+		Reader << Entry.SlotName << Entry.PlayerName << Entry.Score;
+	}
+
+	if (Reader.IsError())
+		return false;
+
+	Profiles    = MoveTemp(NewProfiles);
+	Leaderboard = MoveTemp(NewLeaderboard);
+	Leaderboard.Heapify(FLeaderboardMinScore());
+	return true;
+}
+
+void FABProfileIndex::Write(TArray<uint8>& OutBytes) const
+{
+	TArray<uint8> BodyBytes;
+	FMemoryWriter BodyWriter(BodyBytes);
+
+	int32 NumProfiles = Profiles.Num();
+	BodyWriter << NumProfiles;
+	for (const auto& Pair : Profiles)
+	{
+		FString SlotName          = Pair.Key;
+		FABProfileSummary Summary = Pair.Value;
+		BodyWriter << SlotName << Summary.PlayerName << Summary.Level << Summary.HighScore << Summary.CharacterIndex;
+	}
+
+	int32 NumEntries = Leaderboard.Num();
+	BodyWriter << NumEntries;
+	for (FABLeaderboardEntry Entry : Leaderboard)
+		BodyWriter << Entry.SlotName << Entry.PlayerName << Entry.Score;
+
+	uint32 FileMagic   = Magic;
+	uint16 FileVersion = Version;
+	uint32 BodyCrc     = FCrc::MemCrc32(BodyBytes.GetData(), BodyBytes.Num());
+
+	OutBytes.Reset();
+	FMemoryWriter Writer(OutBytes);
+	Writer << FileMagic << FileVersion << BodyCrc;
+	Writer.Serialize(BodyBytes.GetData(), BodyBytes.Num());
+}
+
+bool FABProfileIndex::UpdateProfile(const FString& SlotName, const FABProfileSummary& Summary)
+{
+	FABProfileSummary& Stored = Profiles.FindOrAdd(SlotName);
+	if (Stored == Summary)
+		return false;
+
+	Stored = Summary;
+	return true;
+}
+
+FString FABProfileIndex::MakeUniqueSlotName(const FString& PlayerName) const
+{
+	const FString BaseName = FPaths::MakeValidFileName(PlayerName, TEXT('_'));
+
+	FString SlotName = BaseName;
+	for (int32 Suffix = 2; Profiles.Contains(SlotName); ++Suffix)
+		SlotName = FString::Printf(TEXT("%s_%d"), *BaseName, Suffix);
+
+	return SlotName;
+}
+
+bool FABProfileIndex::SubmitScore(const FString& SlotName, const FString& PlayerName, int32 Score, int32 MaxEntries)
+{
+	// A slot appears at most once. Finding it is a scan of at most MaxEntries; the heap updates are O(log n).
+	const int32 ExistingIndex = Leaderboard.IndexOfByPredicate([&SlotName](const FABLeaderboardEntry& Entry)
+	{
+		return Entry.SlotName == SlotName;
+	});
+
+	if (INDEX_NONE != ExistingIndex)
+	{
+		if (Leaderboard[ExistingIndex].Score >= Score)
+			return false;
+
+		Leaderboard.HeapRemoveAt(ExistingIndex, FLeaderboardMinScore(), false);
+	}
+	else if (Leaderboard.Num() >= MaxEntries)
+	{
+		if (MaxEntries <= 0 || Leaderboard.HeapTop().Score >= Score)
+			return false;
+
+		FABLeaderboardEntry Displaced;
+		Leaderboard.HeapPop(Displaced, FLeaderboardMinScore(), false);
+	}
+
+	FABLeaderboardEntry NewEntry = { SlotName, PlayerName, Score };
+	Leaderboard.HeapPush(MoveTemp(NewEntry), FLeaderboardMinScore());
+	return true;
+}
+
+void FABProfileIndex::GetLeaderboard(TArray<FABLeaderboardEntry>& OutEntries) const
+{
+	OutEntries = Leaderboard;
+	OutEntries.Sort([](const FABLeaderboardEntry& A, const FABLeaderboardEntry& B)
+	{
+		return A.Score > B.Score;
+	});
+}
@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ABRandomSubsystem.h"
+
+void UABRandomSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+	if (!FParse::Value(CommandLine, TEXT("ABSeed="), Seed))
+	{
+		if (FParse::Param(CommandLine, TEXT("ABBenchmark")))
+			Seed = 0;
+		else
+			Seed = bRandomizeSeed ? (int32)FPlatformTime::Cycles() : DefaultSeed;
+	}
+
+	// Each substream gets its own seed, so drawing more from one never shifts the sequence of another.
+	for (int32 Index = 0; Index < (int32)EABRandomStream::MAX; ++Index)
+		Streams[Index].Initialize((int32)HashCombine(GetTypeHash(Seed), GetTypeHash(Index + 1)));
+
+	ABLOG(Warning, TEXT("Random seed %d for %s (pass -ABSeed=%d to reproduce)"), Seed, *GetWorld()->GetMapName(), Seed);
+}
+
+FRandomStream& UABRandomSubsystem::GetStream(const UObject* WorldContextObject, EABRandomStream Stream)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
+	auto RandomSubsystem = (nullptr != World) ? World->GetSubsystem<UABRandomSubsystem>() : nullptr;
+	if (nullptr != RandomSubsystem)
+		return RandomSubsystem->Streams[(int32)Stream];
+
+	static FRandomStream UnseededStream(FPlatformTime::Cycles());
+	return UnseededStream;
+}
+
+FVector2D UABRandomSubsystem::RandPointInCircle(FRandomStream& Stream, float Radius)
+{
+	const float Angle    = Stream.FRandRange(0.0f, 2.0f * PI);
+	const float Distance = Radius * FMath::Sqrt(Stream.FRand());
+	return FVector2D(FMath::Cos(Angle) * Distance, FMath::Sin(Angle) * Distance);
+}
+
+int32 UABRandomSubsystem::GetSeed() const
+{
+	return Seed;
+}
+
+bool UABRandomSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
@@ -0,0 +1,317 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ABSaveService.h"
+#include "ABPlayerState.h"
+#include "ABSaveGame.h"
+#include "Async/Async.h"
+#include "PlatformFeatures.h"
+#include "SaveGameSystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Save Flush"), STAT_ABSaveFlush, STATGROUP_ArenaBattle);
+DECLARE_CYCLE_STAT(TEXT("Save Serialize"), STAT_ABSaveSerialize, STATGROUP_ArenaBattle);
+DECLARE_CYCLE_STAT(TEXT("Save Disk IO"), STAT_ABSaveDiskIO, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Saves Written"), STAT_ABSavesWritten, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Save Journal Appends"), STAT_ABSaveJournalAppends, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Save Snapshots"), STAT_ABSaveSnapshots, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Save Changes Coalesced"), STAT_ABSaveChangesCoalesced, STATGROUP_ArenaBattle);
+DECLARE_MEMORY_STAT(TEXT("Save Bytes Written"), STAT_ABSaveBytesWritten, STATGROUP_ArenaBattle);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Save Worst Game Thread Time (ms)"), STAT_ABSaveWorstGameThreadMs, STATGROUP_ArenaBattle);
+
+static FAutoConsoleCommandWithWorldAndArgs CmdListProfiles
+(
+	TEXT("ab.Profiles.List"),
+	TEXT("Lists every profile in the save index and the local leaderboard."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UGameInstance* GameInstance = (nullptr != World) ? World->GetGameInstance() : nullptr;
+		UABSaveService* SaveService = (nullptr != GameInstance) ? GameInstance->GetSubsystem<UABSaveService>() : nullptr;
+		if (nullptr != SaveService)
+			SaveService->DumpProfiles(*GLog);
+	})
+);
+
+void UABSaveService::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// The index is a few KB even with hundreds of profiles, and the title screen needs it right away.
+	TArray<uint8> IndexBytes;
+	if (FFileHelper::LoadFileToArray(IndexBytes, *FABProfileIndex::GetIndexPath(), FILEREAD_Silent) && !ProfileIndex.Parse(IndexBytes))
+		ABLOG(Error, TEXT("Profile index is corrupt; it will be rebuilt as profiles are saved."));
+
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UABSaveService::OnTick), 0.25f);
+}
+
+void UABSaveService::Deinitialize()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+
+	Flush();
+	WaitForPendingWrites();
+
+	Super::Deinitialize();
+}
+
+void UABSaveService::MarkDirty(AABPlayerState* PlayerState)
+{
+	ABCHECK(nullptr != PlayerState);
+
+	if (DirtyPlayerStates.Num() == 0)
+		FirstDirtyTime = FPlatformTime::Seconds();
+	else
+		INC_DWORD_STAT(STAT_ABSaveChangesCoalesced);
+
+	DirtyPlayerStates.AddUnique(PlayerState);
+}
+
+void UABSaveService::Flush()
+{
+	AB_SCOPE_CYCLE_COUNTER(STAT_ABSaveFlush);
+
+	TArray<TWeakObjectPtr<AABPlayerState>> PlayerStates = MoveTemp(DirtyPlayerStates);
+	for (const TWeakObjectPtr<AABPlayerState>& PlayerState : PlayerStates)
+	{
+		if (PlayerState.IsValid())
+			SavePlayerState(PlayerState.Get());
+	}
+
+	if (bProfileIndexDirty)
+		WriteProfileIndex();
+}
+
+void UABSaveService::WaitForPendingWrites()
+{
+	if (LastDiskTask.IsValid())
+	{
+		LastDiskTask.Wait();
+		LastDiskTask.Reset();
+	}
+}
+
+void UABSaveService::LoadProfileAsync(const FString& SlotName, FOnProfileLoadedDelegate OnLoaded)
+{
+	TWeakObjectPtr<UABSaveService> WeakThis(this);
+	ISaveGameSystem* SaveGameSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+
+	// Queued behind pending writes, so the read always sees the latest profile without blocking here.
+	QueueDiskTask([WeakThis, SlotName, OnLoaded, SaveGameSystem]()
+	{
+		TArray<uint8> Bytes;
+		FABProfileData Data;
+		int32 NumRecords = 0;
+		bool  bTornTail  = false;
+
+		const bool bParsed = FFileHelper::LoadFileToArray(Bytes, *FABProfileFile::GetProfilePath(SlotName), FILEREAD_Silent)
+			&& FABProfileFile::Parse(Bytes, Data, NumRecords, bTornTail);
+
+		// Older builds saved through USaveGame; read that slot here too so migrating it never touches the disk on the game thread.
+		TArray<uint8> LegacyBytes;
+		if (!bParsed && nullptr != SaveGameSystem && SaveGameSystem->DoesSaveGameExist(*SlotName, 0))
+			SaveGameSystem->LoadGame(false, *SlotName, 0, LegacyBytes);
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, SlotName, bParsed, Data = MoveTemp(Data), NumRecords, bTornTail,
+			LegacyBytes = MoveTemp(LegacyBytes), OnLoaded]()
+		{
+			if (WeakThis.IsValid())
+				WeakThis->OnProfileRead(SlotName, bParsed, Data, NumRecords, bTornTail, LegacyBytes, OnLoaded);
+		});
+	});
+}
+
+void UABSaveService::CreateProfile(const FString& SlotName, const FABProfileData& Data)
+{
+	Slots.FindOrAdd(SlotName).bNeedsSnapshot = true;
+	SaveProfile(SlotName, Data);
+}
+
+FString UABSaveService::CreateNewProfile(const FABProfileData& Data)
+{
+	const FString SlotName = ProfileIndex.MakeUniqueSlotName(Data.PlayerName);
+	CreateProfile(SlotName, Data);
+	WriteProfileIndex();
+
+	return SlotName;
+}
+
+void UABSaveService::SetActiveSlot(const FString& SlotName)
+{
+	ActiveSlotName = SlotName;
+	SaveConfig();
+}
+
+void UABSaveService::SubmitHighScore(const FString& SlotName, const FString& PlayerName, int32 Score)
+{
+	if (ProfileIndex.SubmitScore(SlotName, PlayerName, Score, LeaderboardSize))
+		bProfileIndexDirty = true;
+}
+
+void UABSaveService::DumpProfiles(FOutputDevice& Ar) const
+{
+	for (const auto& Pair : ProfileIndex.GetProfiles())
+	{
+		Ar.Logf(TEXT("%s%-24s %-12s Lv.%-3d High %-5d Skin %d"), (Pair.Key == ActiveSlotName) ? TEXT("* ") : TEXT("  "),
+			*Pair.Key, *Pair.Value.PlayerName, Pair.Value.Level, Pair.Value.HighScore, Pair.Value.CharacterIndex);
+	}
+
+	TArray<FABLeaderboardEntry> Leaderboard;
+	ProfileIndex.GetLeaderboard(Leaderboard);
+	for (int32 Rank = 0; Rank < Leaderboard.Num(); ++Rank)
+		Ar.Logf(TEXT("#%-3d %-12s %d"), Rank + 1, *Leaderboard[Rank].PlayerName, Leaderboard[Rank].Score);
+}
+
+bool UABSaveService::OnTick(float DeltaTime)
+{
+	if ((DirtyPlayerStates.Num() > 0 || bProfileIndexDirty) && FPlatformTime::Seconds() - FirstDirtyTime >= CoalesceSeconds)
+		Flush();
+
+	return true;
+}
+
+void UABSaveService::SavePlayerState(AABPlayerState* PlayerState)
+{
+	FABProfileData Data;
+	PlayerState->WritePlayerData(Data);
+	SaveProfile(PlayerState->SaveSlotName, Data);
+}
+
+void UABSaveService::SaveProfile(const FString& SlotName, const FABProfileData& Data)
+{
+	AB_SCOPE_CYCLE_COUNTER(STAT_ABSaveSerialize);
+	const double StartTime = FPlatformTime::Seconds();
+
+	FSlotState& Slot = Slots.FindOrAdd(SlotName);
+
+	TArray<uint8> Bytes;
+	int32 NumRecords = 0;
+	const bool bAppend = Slot.bHasPersisted && !Slot.bNeedsSnapshot
+		&& FABProfileFile::WriteJournal(Slot.Persisted, Data, Bytes, NumRecords)
+		&& Slot.JournalRecords + NumRecords <= JournalCompactionThreshold;
+
+	if (bAppend && NumRecords == 0)
+		return;
+
+	if (bAppend)
+	{
+		Slot.JournalRecords += NumRecords;
+		INC_DWORD_STAT(STAT_ABSaveJournalAppends);
+	}
+	else
+	{
+		FABProfileFile::WriteSnapshot(Data, Bytes);
+		Slot.JournalRecords = 0;
+		INC_DWORD_STAT(STAT_ABSaveSnapshots);
+	}
+
+	Slot.Persisted      = Data;
+	Slot.bHasPersisted  = true;
+	Slot.bNeedsSnapshot = false;
+
+	if (ProfileIndex.UpdateProfile(SlotName, FABProfileSummary::FromProfile(Data)))
+		bProfileIndexDirty = true;
+
+	const int32 NumBytes = Bytes.Num();
+	TWeakObjectPtr<UABSaveService> WeakThis(this);
+	QueueDiskTask([WeakThis, SlotName, Bytes = MoveTemp(Bytes), ProfilePath = FABProfileFile::GetProfilePath(SlotName), bAppend]()
+	{
+		bool bWritten = false;
+		if (bAppend)
+			bWritten = FFileHelper::SaveArrayToFile(Bytes, *ProfilePath, &IFileManager::Get(), FILEWRITE_Append);
+		else
+		{
+			const FString TempPath = ProfilePath + TEXT(".tmp");
+			bWritten = FFileHelper::SaveArrayToFile(Bytes, *TempPath) && IFileManager::Get().Move(*ProfilePath, *TempPath, true, true);
+		}
+
+		if (!bWritten)
+		{
+			ABLOG(Error, TEXT("Failed to write %s"), *ProfilePath);
+
+			// Slot.Persisted no longer matches the disk, so journal deltas against it would be lost : rewrite the whole profile next time.
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, SlotName]()
+			{
+				if (WeakThis.IsValid())
+					WeakThis->Slots.FindOrAdd(SlotName).bNeedsSnapshot = true;
+			});
+		}
+	});
+
+	const float GameThreadMs = (float)((FPlatformTime::Seconds() - StartTime) * 1000.0);
+	if (GameThreadMs > WorstGameThreadMs)
+	{
+		WorstGameThreadMs = GameThreadMs;
+		SET_FLOAT_STAT(STAT_ABSaveWorstGameThreadMs, WorstGameThreadMs);
+	}
+
+	INC_DWORD_STAT(STAT_ABSavesWritten);
+	INC_MEMORY_STAT_BY(STAT_ABSaveBytesWritten, NumBytes);
+}
+
+void UABSaveService::OnProfileRead(const FString& SlotName, bool bParsed, FABProfileData Data, int32 NumRecords, bool bTornTail,
+	const TArray<uint8>& LegacyBytes, FOnProfileLoadedDelegate OnLoaded)
+{
+	FSlotState& Slot = Slots.FindOrAdd(SlotName);
+
+	if (bParsed)
+	{
+		if (bTornTail)
+			ABLOG(Warning, TEXT("Profile %s had a torn journal tail; kept %d valid records."), *SlotName, NumRecords);
+
+		Slot.Persisted      = Data;
+		Slot.JournalRecords = NumRecords;
+		Slot.bHasPersisted  = true;
+		Slot.bNeedsSnapshot = bTornTail;
+
+		// Profiles written before the index existed get listed the first time they are opened.
+		if (!ProfileIndex.GetProfiles().Contains(SlotName))
+		{
+			ProfileIndex.UpdateProfile(SlotName, FABProfileSummary::FromProfile(Data));
+			WriteProfileIndex();
+		}
+	}
+	else if (LegacyBytes.Num() > 0)
+	{
+		// No usable profile yet : migrate the USaveGame slot written by older builds, read alongside the profile.
+		auto LegacySaveGame = Cast<UABSaveGame>(UGameplayStatics::LoadGameFromMemory(LegacyBytes));
+		if (nullptr != LegacySaveGame)
+		{
+			Data.PlayerName     = LegacySaveGame->PlayerName;
+			Data.Level          = LegacySaveGame->Level;
+			Data.Exp            = LegacySaveGame->Exp;
+			Data.HighScore      = LegacySaveGame->HighScore;
+			Data.CharacterIndex = LegacySaveGame->CharacterIndex;
+
+			ABLOG(Warning, TEXT("Migrating legacy save slot %s to the profile format."), *SlotName);
+			CreateProfile(SlotName, Data);
+		}
+	}
+
+	OnLoaded.ExecuteIfBound(Data);
+}
+
+void UABSaveService::WriteProfileIndex()
+{
+	TArray<uint8> Bytes;
+	ProfileIndex.Write(Bytes);
+	bProfileIndexDirty = false;
+
+	INC_MEMORY_STAT_BY(STAT_ABSaveBytesWritten, Bytes.Num());
+	QueueDiskTask([Bytes = MoveTemp(Bytes), IndexPath = FABProfileIndex::GetIndexPath()]()
+	{
+		const FString TempPath = IndexPath + TEXT(".tmp");
+		if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath) || !IFileManager::Get().Move(*IndexPath, *TempPath, true, true))
+			ABLOG(Error, TEXT("Failed to write %s"), *IndexPath);
+	});
+}
+
+void UABSaveService::QueueDiskTask(TUniqueFunction<void()> Task)
+{
+	LastDiskTask = Async(EAsyncExecution::ThreadPool, [Task = MoveTemp(Task), PreviousTask = MoveTemp(LastDiskTask)]() mutable
+	{
+		if (PreviousTask.IsValid())
+			PreviousTask.Wait();
+
+		AB_SCOPE_CYCLE_COUNTER(STAT_ABSaveDiskIO);
+		Task();
+	});
+}
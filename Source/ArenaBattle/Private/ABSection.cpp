@@ -6,6 +6,18 @@
 #include "ABItem.h"
 #include "ABPlayerController.h"
 #include "ABGameMode.h"
+#include "ABCharacterPoolSubsystem.h"
+#include "ABItemPoolSubsystem.h"
+#include "ABSectionGridSubsystem.h"
+#include "ABSectionStreamingSubsystem.h"
+#include "ABCharacterSetting.h"
+#include "ABCharacterAssetCache.h"
+#include "ABRandomSubsystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Section Set State"), STAT_ABSectionSetState, STATGROUP_ArenaBattle);
+DECLARE_CYCLE_STAT(TEXT("Section Gate Overlap"), STAT_ABSectionGateOverlap, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Section State Changes"), STAT_ABSectionStateChanges, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Section Gate Overlaps"), STAT_ABSectionGateOverlaps, STATGROUP_ArenaBattle);
 
 // Sets default values
 AABSection::AABSection()
@@ -77,10 +89,80 @@ void AABSection::BeginPlay()
 	
 	SetState(bNoBattle ? ESectionState::COMPLETE : ESectionState::READY);
 
+	auto SectionGrid = GetWorld()->GetSubsystem<UABSectionGridSubsystem>();
+	if (nullptr != SectionGrid)
+		SectionGrid->RegisterSection(this);
+}
+
+void AABSection::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	ReleaseKeyNPCAsset();
+
+	auto SectionGrid = GetWorld()->GetSubsystem<UABSectionGridSubsystem>();
+	if (nullptr != SectionGrid)
+		SectionGrid->UnregisterSection(this);
+
+	Super::EndPlay(EndPlayReason);
+}
+
+bool AABSection::IsBattleInProgress() const
+{
+	return CurrentState == ESectionState::BATTLE;
+}
+
+bool AABSection::IsCompleted() const
+{
+	return CurrentState == ESectionState::COMPLETE;
+}
+
+float AABSection::GetGridStep() const
+{
+	for (UBoxComponent* GateTrigger : GateTriggers)
+	{
+		FName SocketName = FName(*GateTrigger->ComponentTags[0].ToString().Left(2));
+		if (Mesh->DoesSocketExist(SocketName))
+			return FVector::Dist2D(GetActorLocation(), Mesh->GetSocketLocation(SocketName));
+	}
+
+	return 0.0f;
+}
+
+void AABSection::ActivateSection(const FVector& Location, const FABSectionCell& Record)
+{
+	SetActorLocation(Location);
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetState(Record.bCompleted ? ESectionState::COMPLETE : ESectionState::READY);
+
+	if (Record.bHasItemBox)
+		AcquireItemBox(Location + Record.ItemBoxOffset);
+}
+
+void AABSection::DeactivateSection(FABSectionCell& OutRecord)
+{
+	GetWorld()->GetTimerManager().ClearTimer(SpawnNPCTimerHandle);
+	GetWorld()->GetTimerManager().ClearTimer(SpawnItemBoxTimerHandle);
+	ReleaseKeyNPCAsset();
+
+	OutRecord.bCompleted  = IsCompleted();
+	OutRecord.bHasItemBox = ItemBox.IsValid();
+	if (ItemBox.IsValid())
+	{
+		// Hand an unclaimed box back to the pool so far sections don't keep item actors alive.
+		OutRecord.ItemBoxOffset = ItemBox->GetActorLocation() - GetActorLocation();
+		GetWorld()->GetSubsystem<UABItemPoolSubsystem>()->ReleaseItem(ItemBox.Get());
+		ItemBox.Reset();
+	}
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
 }
 
 void AABSection::SetState(ESectionState NewState)
 {
+	AB_SCOPE_CYCLE_COUNTER(STAT_ABSectionSetState);
+	INC_DWORD_STAT(STAT_ABSectionStateChanges);
+
 	switch (NewState)
 	{
 	case ESectionState::READY:
@@ -91,6 +173,8 @@ void AABSection::SetState(ESectionState NewState)
 			GateTrigger->SetCollisionProfileName(TEXT("NoCollision"));
 		
 		OperateGate(true);
+
+		PreloadKeyNPCAsset();
 		
 		break;
 	}
@@ -106,18 +190,21 @@ void AABSection::SetState(ESectionState NewState)
 		GetWorld()->GetTimerManager().SetTimer(SpawnNPCTimerHandle, 
 			FTimerDelegate::CreateLambda([this]()->void
 				{
-					auto KeyNPC = GetWorld()->SpawnActor<AABCharacter>(GetActorLocation() + FVector::UpVector * 88.0f, FRotator::ZeroRotator);
+					auto CharacterPool = GetWorld()->GetSubsystem<UABCharacterPoolSubsystem>();
+					auto KeyNPC = CharacterPool->Acquire(GetActorLocation() + FVector::UpVector * 88.0f, FRotator::ZeroRotator,
+						KeyNPCAssetIndex, KeyNPCAssetHandle);
+					ReleaseKeyNPCAsset();
 
 					if (nullptr != KeyNPC)
-						KeyNPC->OnDestroyed.AddDynamic(this, &AABSection::OnKeyNPCDestroyed);
+						KeyNPC->OnCharacterRemoved.AddUObject(this, &AABSection::OnKeyNPCRemoved);
 
 				}), EnemySpawnTime, false);
 
 		GetWorld()->GetTimerManager().SetTimer(SpawnItemBoxTimerHandle,
 			FTimerDelegate::CreateLambda([this]() -> void
 				{
-					FVector2D RandXY = FMath::RandPointInCircle(600.0f);
-					GetWorld()->SpawnActor<AABItem>(GetActorLocation() + FVector(RandXY, 20.0f), FRotator::ZeroRotator);
+					FVector2D RandXY = UABRandomSubsystem::RandPointInCircle(UABRandomSubsystem::GetStream(this, EABRandomStream::SPAWN), 600.0f);
+					AcquireItemBox(GetActorLocation() + FVector(RandXY, 20.0f));
 				}), ItemBoxSpawnTime, false);
 
 		break;
@@ -138,6 +225,40 @@ void AABSection::SetState(ESectionState NewState)
 	CurrentState = NewState;
 }
 
+void AABSection::PreloadKeyNPCAsset()
+{
+	UWorld* World = GetWorld();
+	if (nullptr == World || !World->IsGameWorld() || KeyNPCAssetHandle.IsValid())
+		return;
+
+	auto DefaultSetting = GetDefault<UABCharacterSetting>();
+	if (DefaultSetting->CharacterAssets.Num() == 0)
+		return;
+
+	auto AssetCache   = GetGameInstance()->GetSubsystem<UABCharacterAssetCache>();
+	KeyNPCAssetIndex  = UABRandomSubsystem::GetStream(this, EABRandomStream::SKIN).RandRange(0, DefaultSetting->CharacterAssets.Num() - 1);
+	KeyNPCAssetHandle = AssetCache->RequestSkin(KeyNPCAssetIndex);
+}
+
+void AABSection::ReleaseKeyNPCAsset()
+{
+	KeyNPCAssetHandle.Reset();
+	KeyNPCAssetIndex = INDEX_NONE;
+}
+
+void AABSection::AcquireItemBox(const FVector& Location)
+{
+	auto ItemPool = GetWorld()->GetSubsystem<UABItemPoolSubsystem>();
+	ItemBox = ItemPool->AcquireItem(Location, FRotator::ZeroRotator);
+	if (ItemBox.IsValid())
+		ItemBox->OnItemClaimed.AddUObject(this, &AABSection::OnItemBoxClaimed);
+}
+
+void AABSection::OnItemBoxClaimed()
+{
+	ItemBox.Reset();
+}
+
 void AABSection::OperateGate(bool bOpen)
 {
 	for (UStaticMeshComponent* Gate : GateMeshes)
@@ -156,6 +277,9 @@ void AABSection::OnTriggerBeginOverlap(UPrimitiveComponent* OverlappedComponent,
 void AABSection::OnGateTriggerBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, 
 	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
+	AB_SCOPE_CYCLE_COUNTER(STAT_ABSectionGateOverlap);
+	INC_DWORD_STAT(STAT_ABSectionGateOverlaps);
+
 	ABCHECK(OverlappedComponent->ComponentTags.Num() == 1);
 
 	FName ComponentTag = OverlappedComponent->ComponentTags[0];
@@ -163,15 +287,22 @@ void AABSection::OnGateTriggerBeginOverlap(UPrimitiveComponent* OverlappedCompon
 	if (!Mesh->DoesSocketExist(SocketName))
 		return;
 
-	FVector NewLocation = Mesh->GetSocketLocation(SocketName);
+	auto SectionGrid      = GetWorld()->GetSubsystem<UABSectionGridSubsystem>();
+	auto SectionStreaming = GetWorld()->GetSubsystem<UABSectionStreamingSubsystem>();
+	ABCHECK(nullptr != SectionGrid && nullptr != SectionStreaming);
 
+	FIntPoint NewCell = SectionGrid->WorldToCell(Mesh->GetSocketLocation(SocketName));
+	if (SectionGrid->IsCellOccupied(NewCell))
+		return;
+
+	// The grid only knows about sections; a cell it has never seen may still hold level geometry.
 	TArray<FOverlapResult> OverlapResults;
 	FCollisionQueryParams CollisionQueryParam(NAME_None, false, this);
 	FCollisionObjectQueryParams ObjectQueryParam(FCollisionObjectQueryParams::InitType::AllObjects);
 	bool bResult = GetWorld()->OverlapMultiByObjectType
 	(
 		OverlapResults,
-		NewLocation,
+		SectionGrid->CellToWorld(NewCell),
 		FQuat::Identity,
 		ObjectQueryParam,
 		FCollisionShape::MakeSphere(775.0f),
@@ -179,14 +310,12 @@ void AABSection::OnGateTriggerBeginOverlap(UPrimitiveComponent* OverlappedCompon
 	);
 
 	if (!bResult)
-		auto NewSection = GetWorld()->SpawnActor<AABSection>(NewLocation, FRotator::ZeroRotator);
+		SectionStreaming->AcquireSection(NewCell, FABSectionCell());
 
 }
 
-void AABSection::OnKeyNPCDestroyed(AActor* DestroyedActor)
+void AABSection::OnKeyNPCRemoved(AABCharacter* ABCharacter)
 {
-	auto ABCharacter = Cast<AABCharacter>(DestroyedActor);
-
 	auto ABPlayerController = Cast<AABPlayerController>(ABCharacter->LastHitBy);
 
 	auto ABGameMode = Cast<AABGameMode>(GetWorld()->GetAuthGameMode());
@@ -0,0 +1,141 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ABSectionGridSubsystem.h"
+#include "ABSection.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Section Grid Cells"), STAT_ABSectionGridCells, STATGROUP_ArenaBattle);
+DECLARE_MEMORY_STAT(TEXT("Section Grid Memory"), STAT_ABSectionGridMemory, STATGROUP_ArenaBattle);
+
+static const FIntPoint GSectionNeighborOffsets[] = { FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1) };
+
+void UABSectionGridSubsystem::Deinitialize()
+{
+	Cells.Reset();
+	SET_DWORD_STAT(STAT_ABSectionGridCells, 0);
+	SET_MEMORY_STAT(STAT_ABSectionGridMemory, 0);
+
+	Super::Deinitialize();
+}
+
+void UABSectionGridSubsystem::RegisterSection(AABSection* Section)
+{
+	ABCHECK(nullptr != Section);
+
+	if (!IsGridInitialized())
+	{
+		GridStep   = Section->GetGridStep();
+		GridOrigin = Section->GetActorLocation();
+		ABCHECK(IsGridInitialized());
+	}
+
+	SetSection(WorldToCell(Section->GetActorLocation()), Section);
+}
+
+void UABSectionGridSubsystem::UnregisterSection(AABSection* Section)
+{
+	for (auto It = Cells.CreateIterator(); It; ++It)
+	{
+		if (It->Value.Section.Get() == Section)
+		{
+			It.RemoveCurrent();
+			break;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_ABSectionGridCells, Cells.Num());
+	SET_MEMORY_STAT(STAT_ABSectionGridMemory, Cells.GetAllocatedSize());
+}
+
+FIntPoint UABSectionGridSubsystem::WorldToCell(const FVector& Location) const
+{
+	const FVector Offset = (Location - GridOrigin) / GridStep;
+	return FIntPoint(FMath::RoundToInt(Offset.X), FMath::RoundToInt(Offset.Y));
+}
+
+FVector UABSectionGridSubsystem::CellToWorld(const FIntPoint& Cell) const
+{
+	return GridOrigin + FVector(Cell.X * GridStep, Cell.Y * GridStep, 0.0f);
+}
+
+bool UABSectionGridSubsystem::IsCellOccupied(const FIntPoint& Cell) const
+{
+	return Cells.Contains(Cell);
+}
+
+AABSection* UABSectionGridSubsystem::GetSectionAt(const FIntPoint& Cell) const
+{
+	const FABSectionCell* Found = Cells.Find(Cell);
+	return (nullptr != Found) ? Found->Section.Get() : nullptr;
+}
+
+void UABSectionGridSubsystem::GetOccupiedNeighbors(const FIntPoint& Cell, TArray<FIntPoint>& OutNeighbors) const
+{
+	for (const FIntPoint& Offset : GSectionNeighborOffsets)
+	{
+		if (Cells.Contains(Cell + Offset))
+			OutNeighbors.Add(Cell + Offset);
+	}
+}
+
+void UABSectionGridSubsystem::SetSection(const FIntPoint& Cell, AABSection* Section)
+{
+	Cells.FindOrAdd(Cell).Section = Section;
+	SET_DWORD_STAT(STAT_ABSectionGridCells, Cells.Num());
+	SET_MEMORY_STAT(STAT_ABSectionGridMemory, Cells.GetAllocatedSize());
+}
+
+void UABSectionGridSubsystem::CollapseCell(const FIntPoint& Cell, const FABSectionCell& Record)
+{
+	FABSectionCell* Found = Cells.Find(Cell);
+	ABCHECK(nullptr != Found);
+
+	*Found         = Record;
+	Found->Section = nullptr;
+}
+
+void UABSectionGridSubsystem::SerializeLayout(FArchive& Ar)
+{
+	// Loading replaces the index wholesale, which would orphan the cells of sections already in the world.
+	if (Ar.IsLoading())
+		ABCHECK(Cells.Num() == 0);
+
+	Ar << GridOrigin;
+	Ar << GridStep;
+
+	int32 NumCells = Cells.Num();
+	Ar << NumCells;
+
+	if (Ar.IsLoading())
+	{
+		Cells.Reserve(NumCells);
+
+		for (int32 Index = 0; Index < NumCells; ++Index)
+		{
+			FIntPoint Cell;
+			bool bCompleted = false;
+			Ar << Cell;
+			Ar << bCompleted;
+			Cells.Add(Cell).bCompleted = bCompleted;
+		}
+	}
+	else
+	{
+		for (auto& Pair : Cells)
+		{
+			AABSection* Section = Pair.Value.Section.Get();
+			FIntPoint Cell      = Pair.Key;
+			bool bCompleted     = (nullptr != Section) ? Section->IsCompleted() : Pair.Value.bCompleted;
+			Ar << Cell;
+			Ar << bCompleted;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_ABSectionGridCells, Cells.Num());
+	SET_MEMORY_STAT(STAT_ABSectionGridMemory, Cells.GetAllocatedSize());
+}
+
+bool UABSectionGridSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
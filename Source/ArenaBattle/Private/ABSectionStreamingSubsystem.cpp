@@ -0,0 +1,142 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ABSectionStreamingSubsystem.h"
+#include "ABSectionGridSubsystem.h"
+#include "ABSection.h"
+
+DECLARE_CYCLE_STAT(TEXT("Section Streaming Update"), STAT_ABSectionStreamingUpdate, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Sections Live"), STAT_ABSectionsLive, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Sections Collapsed"), STAT_ABSectionsCollapsed, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Sections Pooled"), STAT_ABSectionsPooled, STATGROUP_ArenaBattle);
+
+void UABSectionStreamingSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	SectionGrid = Collection.InitializeDependency<UABSectionGridSubsystem>();
+}
+
+void UABSectionStreamingSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	InWorld.GetTimerManager().SetTimer(UpdateTimerHandle, FTimerDelegate::CreateUObject(this, &UABSectionStreamingSubsystem::UpdateStreaming),
+		UpdateInterval, true);
+}
+
+void UABSectionStreamingSubsystem::Deinitialize()
+{
+	AvailableSections.Reset();
+	SectionGrid = nullptr;
+
+	SET_DWORD_STAT(STAT_ABSectionsLive, 0);
+	SET_DWORD_STAT(STAT_ABSectionsCollapsed, 0);
+	SET_DWORD_STAT(STAT_ABSectionsPooled, 0);
+
+	Super::Deinitialize();
+}
+
+AABSection* UABSectionStreamingSubsystem::AcquireSection(const FIntPoint& Cell, const FABSectionCell& Record)
+{
+	ABCHECK(nullptr != SectionGrid && SectionGrid->IsGridInitialized(), nullptr);
+
+	const FVector Location = SectionGrid->CellToWorld(Cell);
+
+	AABSection* Section = nullptr;
+	while (nullptr == Section && AvailableSections.Num() > 0)
+	{
+		Section = AvailableSections.Pop(false);
+		if (!IsValid(Section))
+			Section = nullptr;
+	}
+
+	if (nullptr == Section)
+	{
+		// A fresh section registers itself with the grid from BeginPlay.
+		Section = GetWorld()->SpawnActor<AABSection>(Location, FRotator::ZeroRotator);
+		if (nullptr == Section)
+			return nullptr;
+	}
+
+	Section->ActivateSection(Location, Record);
+	SectionGrid->SetSection(Cell, Section);
+
+	return Section;
+}
+
+bool UABSectionStreamingSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UABSectionStreamingSubsystem::UpdateStreaming()
+{
+	AB_SCOPE_CYCLE_COUNTER(STAT_ABSectionStreamingUpdate);
+
+	if (nullptr == SectionGrid || !SectionGrid->IsGridInitialized())
+		return;
+
+	TArray<FIntPoint, TInlineAllocator<4>> PlayerCells;
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APawn* PlayerPawn = It->Get()->GetPawn();
+		if (nullptr != PlayerPawn)
+			PlayerCells.Add(SectionGrid->WorldToCell(PlayerPawn->GetActorLocation()));
+	}
+
+	if (PlayerCells.Num() == 0)
+		return;
+
+	TArray<TPair<FIntPoint, AABSection*>> CellsToCollapse;
+	TArray<TPair<FIntPoint, FABSectionCell>> CellsToRestore;
+	for (const auto& Pair : SectionGrid->GetCells())
+	{
+		int32 Distance = MAX_int32;
+		for (const FIntPoint& PlayerCell : PlayerCells)
+		{
+			const FIntPoint Delta = Pair.Key - PlayerCell;
+			Distance = FMath::Min(Distance, FMath::Max(FMath::Abs(Delta.X), FMath::Abs(Delta.Y)));
+		}
+
+		AABSection* Section = Pair.Value.Section.Get();
+		if (nullptr != Section && Distance > StreamingRadius && !Section->IsBattleInProgress())
+			CellsToCollapse.Emplace(Pair.Key, Section);
+		else if (nullptr == Section && Distance <= StreamingRadius)
+			CellsToRestore.Emplace(Pair.Key, Pair.Value);
+	}
+
+	for (const auto& Pair : CellsToCollapse)
+		CollapseSection(Pair.Key, Pair.Value);
+
+	for (const auto& Pair : CellsToRestore)
+		AcquireSection(Pair.Key, Pair.Value);
+
+	UpdateStats();
+}
+
+void UABSectionStreamingSubsystem::CollapseSection(const FIntPoint& Cell, AABSection* Section)
+{
+	FABSectionCell Record;
+	Section->DeactivateSection(Record);
+	SectionGrid->CollapseCell(Cell, Record);
+
+	if (AvailableSections.Num() >= MaxPooledSections)
+		Section->Destroy();
+	else
+		AvailableSections.Add(Section);
+}
+
+void UABSectionStreamingSubsystem::UpdateStats()
+{
+	int32 LiveCount = 0;
+	for (const auto& Pair : SectionGrid->GetCells())
+	{
+		if (Pair.Value.Section.IsValid())
+			LiveCount++;
+	}
+
+	SET_DWORD_STAT(STAT_ABSectionsLive, LiveCount);
+	SET_DWORD_STAT(STAT_ABSectionsCollapsed, SectionGrid->GetCells().Num() - LiveCount);
+	SET_DWORD_STAT(STAT_ABSectionsPooled, AvailableSections.Num());
+}
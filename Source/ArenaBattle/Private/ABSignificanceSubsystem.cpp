@@ -0,0 +1,180 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ABSignificanceSubsystem.h"
+#include "ABCharacter.h"
+#include "AIController.h"
+#include "BrainComponent.h"
+#include "DrawDebugHelpers.h"
+
+DECLARE_CYCLE_STAT(TEXT("Significance Update"), STAT_ABSignificanceUpdate, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Significance NPCs (High)"), STAT_ABSignificanceHigh, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Significance NPCs (Medium)"), STAT_ABSignificanceMedium, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Significance NPCs (Low)"), STAT_ABSignificanceLow, STATGROUP_ArenaBattle);
+
+static TAutoConsoleVariable<int32> CVarSignificanceDebug
+(
+	TEXT("ab.Significance.Debug"),
+	0,
+	TEXT("1 : Log NPC significance tier changes and draw each NPC's tier above its head."),
+	ECVF_Cheat
+);
+
+namespace ABSignificance
+{
+	struct FTierSettings
+	{
+		float MaxDistance;
+		float BehaviorTreeInterval;
+		float MovementInterval;
+		float AnimationInterval;
+	};
+
+	// Indexed by EABSignificanceTier. Off-screen NPCs are demoted by one tier.
+	static const FTierSettings Tiers[] =
+	{
+		{ 1500.0f, 0.0f,  0.0f,  0.0f        },
+		{ 3000.0f, 0.1f,  0.05f, 1.0f / 15.0f },
+		{ BIG_NUMBER, 0.25f, 0.1f, 0.2f      },
+	};
+
+	static const float UpdateInterval  = 0.25f;
+	static const float VisibilityWindow = 0.2f;
+
+	static const TCHAR* GetTierName(EABSignificanceTier Tier)
+	{
+		switch (Tier)
+		{
+		case EABSignificanceTier::HIGH:   return TEXT("HIGH");
+		case EABSignificanceTier::MEDIUM: return TEXT("MEDIUM");
+		case EABSignificanceTier::LOW:    return TEXT("LOW");
+		}
+		return TEXT("NONE");
+	}
+}
+
+void UABSignificanceSubsystem::Tick(float DeltaTime)
+{
+	TimeSinceUpdate += DeltaTime;
+	if (TimeSinceUpdate < ABSignificance::UpdateInterval)
+		return;
+	TimeSinceUpdate = 0.0f;
+
+	AB_SCOPE_CYCLE_COUNTER(STAT_ABSignificanceUpdate);
+
+	TArray<FVector, TInlineAllocator<4>> PlayerLocations;
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APawn* PlayerPawn = It->Get()->GetPawn();
+		if (nullptr != PlayerPawn)
+			PlayerLocations.Add(PlayerPawn->GetActorLocation());
+	}
+
+	const bool bDebug = CVarSignificanceDebug.GetValueOnGameThread() != 0;
+	int32 TierCounts[(int32)EABSignificanceTier::MAX] = {};
+
+	for (int32 Index = TrackedCharacters.Num() - 1; Index >= 0; --Index)
+	{
+		FTrackedCharacter& Tracked = TrackedCharacters[Index];
+		AABCharacter* Character = Tracked.Character.Get();
+		if (nullptr == Character)
+		{
+			TrackedCharacters.RemoveAtSwap(Index);
+			continue;
+		}
+
+		const EABSignificanceTier NewTier = CalculateTier(Character, PlayerLocations);
+		TierCounts[(int32)NewTier]++;
+
+		if (NewTier != Tracked.Tier)
+		{
+			if (bDebug)
+				ABLOG(Log, TEXT("%s : %s -> %s"), *Character->GetName(), ABSignificance::GetTierName(Tracked.Tier), ABSignificance::GetTierName(NewTier));
+
+			ApplyTier(Character, NewTier);
+			Tracked.Tier = NewTier;
+		}
+
+		if (bDebug)
+		{
+			DrawDebugString(GetWorld(), FVector(0.0f, 0.0f, 120.0f), ABSignificance::GetTierName(NewTier), Character,
+				FColor::Yellow, ABSignificance::UpdateInterval);
+		}
+	}
+
+	SET_DWORD_STAT(STAT_ABSignificanceHigh, TierCounts[(int32)EABSignificanceTier::HIGH]);
+	SET_DWORD_STAT(STAT_ABSignificanceMedium, TierCounts[(int32)EABSignificanceTier::MEDIUM]);
+	SET_DWORD_STAT(STAT_ABSignificanceLow, TierCounts[(int32)EABSignificanceTier::LOW]);
+}
+
+TStatId UABSignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UABSignificanceSubsystem, STATGROUP_ArenaBattle);
+}
+
+void UABSignificanceSubsystem::RegisterCharacter(AABCharacter* Character)
+{
+	ABCHECK(nullptr != Character);
+
+	for (const FTrackedCharacter& Tracked : TrackedCharacters)
+	{
+		if (Tracked.Character.Get() == Character)
+			return;
+	}
+
+	Character->GetMesh()->bEnableUpdateRateOptimizations = true;
+
+	FTrackedCharacter NewTracked;
+	NewTracked.Character = Character;
+	TrackedCharacters.Add(NewTracked);
+}
+
+void UABSignificanceSubsystem::UnregisterCharacter(AABCharacter* Character)
+{
+	for (int32 Index = 0; Index < TrackedCharacters.Num(); ++Index)
+	{
+		if (TrackedCharacters[Index].Character.Get() == Character)
+		{
+			ApplyTier(Character, EABSignificanceTier::HIGH);
+			TrackedCharacters.RemoveAtSwap(Index);
+			return;
+		}
+	}
+}
+
+bool UABSignificanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+EABSignificanceTier UABSignificanceSubsystem::CalculateTier(const AABCharacter* Character, TArrayView<const FVector> PlayerLocations) const
+{
+	float NearestDistSq = BIG_NUMBER;
+	for (const FVector& PlayerLocation : PlayerLocations)
+		NearestDistSq = FMath::Min(NearestDistSq, FVector::DistSquared(PlayerLocation, Character->GetActorLocation()));
+
+	int32 Tier = 0;
+	while (Tier < (int32)EABSignificanceTier::LOW && NearestDistSq > FMath::Square(ABSignificance::Tiers[Tier].MaxDistance))
+		Tier++;
+
+	if (!Character->WasRecentlyRendered(ABSignificance::VisibilityWindow))
+		Tier = FMath::Min(Tier + 1, (int32)EABSignificanceTier::LOW);
+
+	return (EABSignificanceTier)Tier;
+}
+
+void UABSignificanceSubsystem::ApplyTier(AABCharacter* Character, EABSignificanceTier Tier) const
+{
+	const ABSignificance::FTierSettings& Settings = ABSignificance::Tiers[(int32)Tier];
+
+	auto AIController = Cast<AAIController>(Character->GetController());
+	if (nullptr != AIController && nullptr != AIController->GetBrainComponent())
+		AIController->GetBrainComponent()->SetComponentTickInterval(Settings.BehaviorTreeInterval);
+
+	Character->GetCharacterMovement()->SetComponentTickInterval(Settings.MovementInterval);
+
+	USkeletalMeshComponent* Mesh = Character->GetMesh();
+	Mesh->SetComponentTickInterval(Settings.AnimationInterval);
+	Mesh->VisibilityBasedAnimTickOption = (Tier == EABSignificanceTier::LOW) ?
+		EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered : EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+}
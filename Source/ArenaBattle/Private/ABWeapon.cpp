@@ -2,6 +2,7 @@
 
 
 #include "ABWeapon.h"
+#include "ABRandomSubsystem.h"
 
 // Sets default values
 AABWeapon::AABWeapon()
@@ -42,15 +43,45 @@ float AABWeapon::GetAttackModifier() const
 	return AttackModifier;
 }
 
+void AABWeapon::ApplyWeaponData(TSubclassOf<AABWeapon> WeaponClass)
+{
+	ABCHECK(nullptr != WeaponClass);
+
+	if (AppliedWeaponClass != WeaponClass)
+	{
+		auto WeaponData = WeaponClass->GetDefaultObject<AABWeapon>();
+		Weapon->SetSkeletalMesh(WeaponData->Weapon->GetSkeletalMeshAsset());
+
+		AttackRange		   = WeaponData->AttackRange;
+		AttackDamageMin	   = WeaponData->AttackDamageMin;
+		AttackDamageMax	   = WeaponData->AttackDamageMax;
+		AttackModifierMin  = WeaponData->AttackModifierMin;
+		AttackModifierMax  = WeaponData->AttackModifierMax;
+		AppliedWeaponClass = WeaponClass;
+	}
+
+	RollStats();
+}
+
+void AABWeapon::RollStats()
+{
+	FRandomStream& LootStream = UABRandomSubsystem::GetStream(this, EABRandomStream::LOOT);
+	AttackDamage   = LootStream.FRandRange(AttackDamageMin, AttackDamageMax);
+	AttackModifier = LootStream.FRandRange(AttackModifierMin, AttackModifierMax);
+
+	ABLOG(Warning, TEXT("Weapon Damage : %f, Modifier : %f"), AttackDamage, AttackModifier);
+}
+
 // Called when the game starts or when spawned
 void AABWeapon::BeginPlay()
 {
 	Super::BeginPlay();
 	
-	AttackDamage = FMath::RandRange(AttackDamageMin, AttackDamageMax);
-	AttackModifier = FMath::RandRange(AttackModifierMin, AttackModifierMax);
-
-	ABLOG(Warning, TEXT("Weapon Damage : %f, Modifier : %f"), AttackDamage, AttackModifier);
+	if (nullptr == AppliedWeaponClass)
+	{
+		AppliedWeaponClass = GetClass();
+		RollStats();
+	}
 }
 
 // Called every frame
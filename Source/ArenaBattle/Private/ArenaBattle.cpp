@@ -5,5 +5,6 @@
 
 
 DEFINE_LOG_CATEGORY(ArenaBattle);
+CSV_DEFINE_CATEGORY_MODULE(ARENABATTLE_API, ArenaBattle, true);
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, ArenaBattle, "ArenaBattle" );
  
\ No newline at end of file
@@ -4,28 +4,86 @@
 #include "BTService_Detect.h"
 #include "ABAIController.h"
 #include "ABCharacter.h"
+#include "ABPerceptionSubsystem.h"
+#include "ABDetectScheduler.h"
 #include "BehaviorTree/BlackboardComponent.h"
 #include "DrawDebugHelpers.h"
 
+DECLARE_CYCLE_STAT(TEXT("Detect Service Tick"), STAT_ABDetectServiceTick, STATGROUP_ArenaBattle);
+DECLARE_CYCLE_STAT(TEXT("Detect Physics Overlap"), STAT_ABDetectPhysicsOverlap, STATGROUP_ArenaBattle);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Detect Service Ticks"), STAT_ABDetectServiceTicks, STATGROUP_ArenaBattle);
+
+static TAutoConsoleVariable<int32> CVarDetectUseSpatialHash
+(
+	TEXT("ab.Detect.UseSpatialHash"),
+	1,
+	TEXT("1 : NPC detection queries the shared perception spatial hash.\n")
+	TEXT("0 : NPC detection runs its own OverlapMultiByChannel against the physics scene."),
+	ECVF_Default
+);
+
 UBTService_Detect::UBTService_Detect()
 {
 	NodeName = TEXT("Detect");
 	Interval = 1.0f;
 }
 
-void UBTService_Detect::TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
+void UBTService_Detect::DetectTarget(UBehaviorTreeComponent& OwnerComp, float DetectRadios)
 {
-	Super::TickNode(OwnerComp, NodeMemory, DeltaSeconds);
-
 	APawn* ControllingPawn = OwnerComp.GetAIOwner()->GetPawn();
 	if (nullptr == ControllingPawn) return;
 
-	UWorld* World        = ControllingPawn->GetWorld();
-	FVector Center       = ControllingPawn->GetActorLocation();
-	float   DetectRadios = 600.0f;
+	UWorld* World  = ControllingPawn->GetWorld();
+	FVector Center = ControllingPawn->GetActorLocation();
 
 	if (nullptr == World) return;
-	
+
+	auto Perception = World->GetSubsystem<UABPerceptionSubsystem>();
+
+	AABCharacter* ABCharacter = nullptr;
+	if (nullptr != Perception && CVarDetectUseSpatialHash.GetValueOnGameThread() != 0)
+		ABCharacter = Perception->FindPlayerInRadius(Center, DetectRadios, ControllingPawn);
+	else
+		ABCharacter = FindPlayerByOverlap(ControllingPawn, Center, DetectRadios);
+
+	if (nullptr != ABCharacter)
+	{
+		OwnerComp.GetBlackboardComponent()->SetValueAsObject(AABAIController::TargetKey, ABCharacter);
+
+		DrawDebugSphere(World, Center, DetectRadios, 16, FColor::Green, false, 0.4f);
+		DrawDebugPoint(World, ABCharacter->GetActorLocation(), 10.0f, FColor::Blue, false, 0.4f);
+		DrawDebugLine(World, ControllingPawn->GetActorLocation(), ABCharacter->GetActorLocation(), FColor::Blue, false, 0.4f);
+		return;
+	}
+
+	DrawDebugSphere(World, Center, DetectRadios, 16, FColor::Red, false, 0.4f);
+}
+
+void UBTService_Detect::TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
+{
+	AB_SCOPE_CYCLE_COUNTER(STAT_ABDetectServiceTick);
+	INC_DWORD_STAT(STAT_ABDetectServiceTicks);
+
+	Super::TickNode(OwnerComp, NodeMemory, DeltaSeconds);
+
+	float DetectRadios = 600.0f;
+
+	auto Scheduler = OwnerComp.GetWorld()->GetSubsystem<UABDetectScheduler>();
+	if (nullptr != Scheduler && UABDetectScheduler::IsEnabled())
+		Scheduler->RequestDetect(OwnerComp, DetectRadios);
+	else
+		DetectTarget(OwnerComp, DetectRadios);
+}
+
+AABCharacter* UBTService_Detect::FindPlayerByOverlap(APawn* ControllingPawn, const FVector& Center, float DetectRadios)
+{
+	AB_SCOPE_CYCLE_COUNTER(STAT_ABDetectPhysicsOverlap);
+
+	UWorld* World   = ControllingPawn->GetWorld();
+	auto Perception = World->GetSubsystem<UABPerceptionSubsystem>();
+	if (nullptr != Perception)
+		Perception->NotifyPhysicsQuery();
+
 	TArray<FOverlapResult> OverlapResults;
 	FCollisionQueryParams CollisionQueryParam(NAME_None, false, ControllingPawn);
 
@@ -45,16 +103,9 @@ void UBTService_Detect::TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeM
 		{
 			AABCharacter* ABCharacter = Cast<AABCharacter>(OverlapResult.GetActor());
 			if (ABCharacter && ABCharacter->GetController()->IsPlayerController())
-			{
-				OwnerComp.GetBlackboardComponent()->SetValueAsObject(AABAIController::TargetKey, ABCharacter);
-				
-				DrawDebugSphere(World, Center, DetectRadios, 16, FColor::Green, false, 0.4f);
-				DrawDebugPoint(World, ABCharacter->GetActorLocation(), 10.0f, FColor::Blue, false, 0.4f);
-				DrawDebugLine(World, ControllingPawn->GetActorLocation(), ABCharacter->GetActorLocation(), FColor::Blue, false, 0.4f);
-				return;
-			}
+				return ABCharacter;
 		}
 	}
 
-	DrawDebugSphere(World, Center, DetectRadios, 16, FColor::Red, false, 0.4f);
+	return nullptr;
 }
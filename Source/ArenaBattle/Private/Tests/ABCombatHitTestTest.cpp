@@ -0,0 +1,157 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ABCombatHitTestSubsystem.h"
+#include "GameFramework/Character.h"
+#include "Components/CapsuleComponent.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ABCombatHitTestTest
+{
+	static bool HitsEqual(FAutomationTestBase& Test, const FString& What, const TArray<FABSwingHit>& Actual, const TArray<FABSwingHit>& Expected)
+	{
+		if (!Test.TestEqual(What + TEXT(" hit count"), Actual.Num(), Expected.Num()))
+			return false;
+
+		for (int32 Index = 0; Index < Actual.Num(); ++Index)
+		{
+			if (Actual[Index].Swing != Expected[Index].Swing || Actual[Index].Combatant != Expected[Index].Combatant)
+			{
+				Test.AddError(FString::Printf(TEXT("%s hit %d : swing %d / combatant %d, expected swing %d / combatant %d"), *What, Index,
+					Actual[Index].Swing, Actual[Index].Combatant, Expected[Index].Swing, Expected[Index].Combatant));
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FABCombatHitTestVectorMatchesScalarTest, "ArenaBattle.Combat.HitTest.VectorMatchesScalar",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FABCombatHitTestVectorMatchesScalarTest::RunTest(const FString& Parameters)
+{
+	for (int32 NumCombatants : { 1000, 10000 })
+	{
+		FABCombatantBuffer Buffer;
+		TArray<FABSwing>   Swings;
+		UABCombatHitTestSubsystem::MakeBenchmarkScenario(NumCombatants, 64, Buffer, Swings);
+
+		TArray<FABSwingHit> VectorHits;
+		TArray<FABSwingHit> ScalarHits;
+		Buffer.TestSwings(Swings, VectorHits);
+		Buffer.TestSwingsScalar(Swings, ScalarHits);
+
+		ABCombatHitTestTest::HitsEqual(*this, FString::Printf(TEXT("%d combatants"), NumCombatants), VectorHits, ScalarHits);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FABCombatHitTestMatchesPhysicsTest, "ArenaBattle.Combat.HitTest.MatchesPhysics",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FABCombatHitTestMatchesPhysicsTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("ABCombatHitTestWorld"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	// Plain ACharacters with the ABCharacter collision profile have the same capsule and the same Attack channel
+	// response as AABCharacter, without its game instance, player state and asset cache dependencies.
+	// The world never begins play, so nothing ticks or moves them.
+	TArray<ACharacter*> Characters;
+	FABCombatantBuffer  Buffer;
+	for (int32 X = 0; X < 5; ++X)
+	{
+		for (int32 Y = 0; Y < 5; ++Y)
+		{
+			const FVector Location(X * 250.0f, Y * 250.0f, (X + Y) % 3 * 60.0f);
+
+			ACharacter* Character = World->SpawnActor<ACharacter>(Location, FRotator::ZeroRotator);
+			if (!TestNotNull(TEXT("Spawned character"), Character))
+				continue;
+
+			UCapsuleComponent* Capsule = Character->GetCapsuleComponent();
+			Capsule->SetCollisionProfileName(TEXT("ABCharacter"));
+
+			Characters.Add(Character);
+			Buffer.Add(Capsule->GetComponentLocation(), Capsule->GetScaledCapsuleRadius(), Capsule->GetScaledCapsuleHalfHeight());
+		}
+	}
+
+	// One frame so the physics scene's query structure picks up the spawned capsules.
+	World->Tick(LEVELTICK_All, 1.0f / 60.0f);
+
+	// Swings of AttackCheck's shape : a 50 radius sphere swept 150 to 400 units from around the crowd.
+	FRandomStream Random(42);
+	TArray<FABSwing> Swings;
+	for (int32 Index = 0; Index < 256; ++Index)
+	{
+		const FVector Start(Random.FRandRange(-200.0f, 1200.0f), Random.FRandRange(-200.0f, 1200.0f), Random.FRandRange(-50.0f, 170.0f));
+		const FVector Dir = FRotator(0.0f, Random.FRandRange(0.0f, 360.0f), 0.0f).Vector();
+		Swings.Add({ Start, Start + Dir * Random.FRandRange(150.0f, 400.0f), 50.0f });
+	}
+
+	TArray<FABSwingHit> AnalyticHits;
+	Buffer.TestSwings(Swings, AnalyticHits);
+
+	FCollisionQueryParams Params(NAME_None, false);
+	FCollisionResponseParams ResponseParams;
+	ResponseParams.CollisionResponse.SetAllChannels(ECR_Overlap);
+
+	int32 NumCompared = 0;
+	int32 NumHitSwings = 0;
+	int32 HitIndex = 0;
+
+	for (int32 SwingIndex = 0; SwingIndex < Swings.Num(); ++SwingIndex)
+	{
+		const FABSwing& Swing = Swings[SwingIndex];
+
+		TSet<AActor*> AnalyticActors;
+		for (; HitIndex < AnalyticHits.Num() && AnalyticHits[HitIndex].Swing == SwingIndex; ++HitIndex)
+			AnalyticActors.Add(Characters[AnalyticHits[HitIndex].Combatant]);
+
+		// Physics pads shapes by a small contact offset, so swings that graze a capsule within a unit or two are not compared.
+		TArray<FABSwingHit> InnerHits;
+		TArray<FABSwingHit> OuterHits;
+		const FABSwing Inner[] = { { Swing.Start, Swing.End, Swing.Radius - 2.0f } };
+		const FABSwing Outer[] = { { Swing.Start, Swing.End, Swing.Radius + 2.0f } };
+		Buffer.TestSwingsScalar(Inner, InnerHits);
+		Buffer.TestSwingsScalar(Outer, OuterHits);
+		if (InnerHits.Num() != OuterHits.Num())
+			continue;
+
+		TArray<FHitResult> PhysicsHits;
+		World->SweepMultiByChannel(PhysicsHits, Swing.Start, Swing.End, FQuat::Identity, ECollisionChannel::ECC_GameTraceChannel2,
+			FCollisionShape::MakeSphere(Swing.Radius), Params, ResponseParams);
+
+		TSet<AActor*> PhysicsActors;
+		for (const FHitResult& Hit : PhysicsHits)
+			PhysicsActors.Add(Hit.GetActor());
+
+		NumCompared++;
+		if (AnalyticActors.Num() > 0)
+			NumHitSwings++;
+
+		if (AnalyticActors.Num() != PhysicsActors.Num() || AnalyticActors.Difference(PhysicsActors).Num() > 0)
+		{
+			AddError(FString::Printf(TEXT("Swing %d from %s to %s : %d analytic targets, %d physics targets"), SwingIndex,
+				*Swing.Start.ToString(), *Swing.End.ToString(), AnalyticActors.Num(), PhysicsActors.Num()));
+		}
+	}
+
+	// Guards against a layout change that silently stops exercising the comparison.
+	TestTrue(TEXT("Most swings are unambiguous"), NumCompared > Swings.Num() / 2);
+	TestTrue(TEXT("Some swings hit a character"), NumHitSwings > 0);
+	TestTrue(TEXT("Some swings miss every character"), NumHitSwings < NumCompared);
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif
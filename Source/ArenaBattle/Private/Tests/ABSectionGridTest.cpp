@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ABSectionGridSubsystem.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FABSectionGridLayoutRoundTripTest, "ArenaBattle.Section.Grid.LayoutRoundTrip",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FABSectionGridLayoutRoundTripTest::RunTest(const FString& Parameters)
+{
+	// A layout as SerializeLayout writes it : origin, step, then each cell with its completion state.
+	FVector GridOrigin(400.0f, -1200.0f, 0.0f);
+	float   GridStep = 1600.0f;
+	const TPair<FIntPoint, bool> Layout[] = { { FIntPoint(0, 0), true }, { FIntPoint(1, 0), true }, { FIntPoint(1, -1), false } };
+
+	TArray<uint8> LayoutBytes;
+	{
+		FMemoryWriter Writer(LayoutBytes);
+		int32 NumCells = UE_ARRAY_COUNT(Layout);
+		Writer << GridOrigin << GridStep << NumCells;
+
+		for (TPair<FIntPoint, bool> Cell : Layout)
+			Writer << Cell.Key << Cell.Value;
+	}
+
+	UABSectionGridSubsystem* Grid = NewObject<UABSectionGridSubsystem>();
+	{
+		FMemoryReader Reader(LayoutBytes);
+		Grid->SerializeLayout(Reader);
+	}
+
+	TestTrue(TEXT("Grid initialized from the layout"), Grid->IsGridInitialized());
+	TestEqual(TEXT("Cell origin"), Grid->CellToWorld(FIntPoint(0, 0)), GridOrigin);
+	TestEqual(TEXT("Cell step"), Grid->CellToWorld(FIntPoint(1, -1)), GridOrigin + FVector(GridStep, -GridStep, 0.0f));
+	TestEqual(TEXT("Cell count"), Grid->GetCells().Num(), (int32)UE_ARRAY_COUNT(Layout));
+
+	for (const TPair<FIntPoint, bool>& Cell : Layout)
+	{
+		const FABSectionCell* Loaded = Grid->GetCells().Find(Cell.Key);
+		if (TestNotNull(*FString::Printf(TEXT("Cell %s"), *Cell.Key.ToString()), Loaded))
+		{
+			TestEqual(*FString::Printf(TEXT("Cell %s completed"), *Cell.Key.ToString()), Loaded->bCompleted, Cell.Value);
+			TestFalse(*FString::Printf(TEXT("Cell %s collapsed"), *Cell.Key.ToString()), Loaded->Section.IsValid());
+		}
+	}
+
+	TArray<FIntPoint> Neighbors;
+	Grid->GetOccupiedNeighbors(FIntPoint(1, 0), Neighbors);
+	TestEqual(TEXT("Neighbors of (1, 0)"), Neighbors.Num(), 2);
+
+	TArray<uint8> SavedBytes;
+	{
+		FMemoryWriter Writer(SavedBytes);
+		Grid->SerializeLayout(Writer);
+	}
+	TestTrue(TEXT("Saved layout matches the loaded one"), SavedBytes == LayoutBytes);
+
+	// Loading over a populated grid would drop the cells of live sections, so it is refused.
+	AddExpectedError(TEXT("Cells.Num() == 0"), EAutomationExpectedErrorFlags::Contains, 1);
+	{
+		TArray<uint8> EmptyBytes;
+		FMemoryWriter Writer(EmptyBytes);
+		FVector OtherOrigin = FVector::ZeroVector;
+		float   OtherStep   = 800.0f;
+		int32   NumCells    = 0;
+		Writer << OtherOrigin << OtherStep << NumCells;
+
+		FMemoryReader Reader(EmptyBytes);
+		Grid->SerializeLayout(Reader);
+	}
+	TestEqual(TEXT("Cells kept after a refused load"), Grid->GetCells().Num(), (int32)UE_ARRAY_COUNT(Layout));
+	TestEqual(TEXT("Origin kept after a refused load"), Grid->CellToWorld(FIntPoint(0, 0)), GridOrigin);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,87 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "ArenaBattle.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ABBenchmarkSubsystem.generated.h"
+
+/**
+ * Headless throughput benchmark, only created when the game is launched with -ABBenchmark :
+ *   ArenaBattle Gameplay -game -nullrhi -benchmark -fps=60 -ABBenchmark [-ABBenchSections=1] [-ABBenchNPCs=16]
+ *     [-ABBenchWarmup=120] [-ABBenchFrames=1800] [-ABSeed=0] [-ABBenchReport=<path>]
+ * Fills a grid of sections around the player, keeps NPCs respawning around it, drives the player as a bot,
+ * and writes a JSON report of frame times, ArenaBattle stats, spawn counts and memory before exiting.
+ */
+UCLASS(config=ArenaBattle)
+class ARENABATTLE_API UABBenchmarkSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FStatSample
+	{
+		double TotalMs = 0.0;
+		double MaxMs   = 0.0;
+		int64  Calls   = 0;
+		int32  Frames  = 0;
+	};
+
+	void StartScenario(class AABCharacter* Player);
+	bool SpawnNPC();
+	void OnNPCRemoved(class AABCharacter* NPC);
+	void DriveBot(class AABCharacter* Player);
+	void SampleFrame(float FrameTimeMs);
+	void SampleStats();
+	void WriteReport();
+
+	UPROPERTY(config)
+	int32 SectionRadius = 1;
+
+	UPROPERTY(config)
+	int32 NumNPCs = 16;
+
+	UPROPERTY(config)
+	int32 WarmupFrames = 120;
+
+	UPROPERTY(config)
+	int32 MeasuredFrames = 1800;
+
+	UPROPERTY(config)
+	float NPCSpawnRadius = 1200.0f;
+
+	FString ReportPath;
+
+	FVector Origin        = FVector::ZeroVector;
+	bool    bStarted      = false;
+	bool    bFinished     = false;
+	int32   FrameIndex    = 0;
+	double  LastFrameTime = 0.0;
+
+	int32 LiveNPCs        = 0;
+	int32 NPCsSpawned     = 0;
+	int32 NPCsKilled      = 0;
+	int32 SectionsSpawned = 0;
+	int32 ActorsSpawned   = 0;
+	int32 BotAttackInputs = 0;
+
+	TArray<float> FrameMs;
+	TArray<float> GameThreadMs;
+	TMap<FString, FStatSample> CycleStats;
+	TMap<FString, double> CounterStats;
+	uint64 PeakUsedPhysical = 0;
+	uint64 PeakUsedVirtual  = 0;
+
+	FDelegateHandle ActorSpawnedHandle;
+};
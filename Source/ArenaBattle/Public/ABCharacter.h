@@ -7,6 +7,7 @@
 #include "ABCharacter.generated.h"
 
 DECLARE_MULTICAST_DELEGATE(FOnAttackEndDelegate);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnCharacterRemovedDelegate, class AABCharacter*);
 
 UCLASS()
 class ARENABATTLE_API AABCharacter : public ACharacter
@@ -22,9 +23,16 @@ public:
 	float GetFinalAttackRange() const;
 	float GetFinalAttackDamage() const;
 
+	void ActivateFromPool(const FVector& Location, const FRotator& Rotation, int32 PreloadedAssetIndex = INDEX_NONE,
+		TSharedPtr<struct FABSkinHandle> PreloadHandle = nullptr);
+	void ReturnToPool();
+	bool IsInPool() const;
+	FOnCharacterRemovedDelegate OnCharacterRemoved;
+
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	enum class EControlMode
 	{
@@ -54,7 +62,8 @@ public:
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
 	bool CanSetWeapon();
-	void SetWeapon(class AABWeapon* NewWeapon);
+	void EquipWeapon(TSubclassOf<class AABWeapon> WeaponClass);
+	void UnequipWeapon();
 	void Attack();
 	FOnAttackEndDelegate OnAttackEnd;
 
@@ -82,6 +91,7 @@ private:
 	virtual void Jump() override;
 	
 	void ViewChange();
+	void StartLoading(int32 PreloadedAssetIndex = INDEX_NONE, TSharedPtr<struct FABSkinHandle> PreloadHandle = nullptr);
 	void OnAssetLoadCompleted();
 
 	UFUNCTION()
@@ -90,6 +100,8 @@ private:
 	void AttackStartComboState();
 	void AttackEndComboState();
 	void AttackCheck();
+	void OnAttackTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+	void ResolveAttackCheck(TArrayView<const FHitResult> Hits, const FVector& TraceStart, const FVector& TraceEnd);
 
 private:
 	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = Attack, Meta = (AllowPrivateAccess = true))
@@ -116,10 +128,17 @@ private:
 	UPROPERTY()
 	class UABAnimInstance* ABAnim;
 
-	FSoftObjectPath CharacterAssetToLoad = FSoftObjectPath(nullptr);
-	TSharedPtr<struct FStreamableHandle> AssetStreamingHandle;
+	UPROPERTY()
+	class AABWeapon* WeaponSlot;
+
+	TSharedPtr<struct FABSkinHandle> SkinHandle;
+	FTraceDelegate AttackTraceDelegate;
+
+	// Everything already damaged during the current combo section, so later hit windows of the same swing skip it.
+	TArray<TWeakObjectPtr<AActor>, TInlineAllocator<8>> ComboSectionHitActors;
 
 	int32 AssetIndex = 0;
+	double LoadingStartTime = 0.0;
 
 	UPROPERTY(Transient, VisibleInstanceOnly, BlueprintReadOnly, Category = State, Meta = (AllowprivateAccess = true))
 	ECharacterState CurrentState;
@@ -137,4 +156,9 @@ private:
 	float DeadTimer;
 
 	FTimerHandle DeadTimerHandle = {};
+	FDelegateHandle HPIsZeroHandle;
+
+	friend class UABCharacterPoolSubsystem;
+	friend class UABCombatHitTestSubsystem;
+	bool bInPool = false;
 };
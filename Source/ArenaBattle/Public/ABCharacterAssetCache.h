@@ -0,0 +1,73 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "ArenaBattle.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "ABCharacterAssetCache.generated.h"
+
+/**
+ * Shared reference to one UABCharacterSetting::CharacterAssets skin.
+ * The skin cannot be evicted while any handle to it is alive.
+ */
+struct ARENABATTLE_API FABSkinHandle
+{
+	~FABSkinHandle();
+
+	int32 GetAssetIndex() const { return AssetIndex; }
+	bool IsLoaded() const;
+	USkeletalMesh* GetSkin() const;
+
+	// Returns false when the skin is already loaded; the delegate is not called in that case.
+	bool BindOnLoaded(FSimpleDelegate InOnLoaded);
+
+private:
+	friend class UABCharacterAssetCache;
+
+	int32 AssetIndex = INDEX_NONE;
+	TWeakObjectPtr<class UABCharacterAssetCache> Cache;
+	FSimpleDelegate OnLoaded;
+};
+
+/**
+ * Loads CharacterAssets skins once per game instance and hands out FABSkinHandles to them.
+ * Unreferenced skins stay resident for instant reuse until ResidentBudgetMB is exceeded, then the least recently used go first.
+ */
+UCLASS(config=ArenaBattle)
+class ARENABATTLE_API UABCharacterAssetCache : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	TSharedPtr<FABSkinHandle> RequestSkin(int32 AssetIndex);
+
+	void DumpResidentSkins(FOutputDevice& Ar) const;
+
+private:
+	friend struct FABSkinHandle;
+
+	struct FSkinEntry
+	{
+		TSharedPtr<struct FStreamableHandle> StreamableHandle;
+		TArray<TWeakPtr<FABSkinHandle>> Waiters;
+		int32  RefCount      = 0;
+		int64  ResidentBytes = 0;
+		double LastUsedTime  = 0.0;
+	};
+
+	TSharedPtr<FABSkinHandle> MakeHandle(int32 AssetIndex, FSkinEntry& Entry);
+	FSkinEntry* FindOrLoadEntry(int32 AssetIndex);
+	void OnSkinLoaded(int32 AssetIndex);
+	void ReleaseSkin(int32 AssetIndex);
+	bool IsSkinLoaded(int32 AssetIndex) const;
+	USkeletalMesh* GetLoadedSkin(int32 AssetIndex) const;
+	void EnforceBudget();
+	void UpdateStats() const;
+
+	UPROPERTY(config)
+	int32 ResidentBudgetMB = 256;
+
+	TMap<int32, FSkinEntry> Entries;
+};
@@ -0,0 +1,40 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "ArenaBattle.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ABCharacterPoolSubsystem.generated.h"
+
+/**
+ * Keeps hidden, collision-disabled NPC AABCharacters around so sections reuse them instead of spawning new ones.
+ */
+UCLASS(config=ArenaBattle)
+class ARENABATTLE_API UABCharacterPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	// PreloadHandle keeps an already requested skin resident until the character picks it up.
+	class AABCharacter* Acquire(const FVector& Location, const FRotator& Rotation, int32 PreloadedAssetIndex = INDEX_NONE,
+		TSharedPtr<struct FABSkinHandle> PreloadHandle = nullptr);
+	void Release(class AABCharacter* Character);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	class AABCharacter* SpawnPooledCharacter();
+
+	UPROPERTY(config)
+	int32 MaxPoolSize = 16;
+
+	UPROPERTY(config)
+	int32 PrewarmCount = 4;
+
+	UPROPERTY()
+	TArray<class AABCharacter*> AvailableCharacters;
+};
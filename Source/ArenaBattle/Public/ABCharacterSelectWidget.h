@@ -50,4 +50,12 @@ private:
 
 	UFUNCTION()
 	void OnConfirmClicked();
+
+	void PrefetchNeighborSkins();
+	void OnDisplayedSkinLoaded();
+
+	// Current skin plus the previous and next ones, so a click is normally served from memory.
+	TSharedPtr<struct FABSkinHandle> DisplayedSkin;
+	TSharedPtr<struct FABSkinHandle> NeighborSkins[2];
+	double ClickTime = 0.0;
 };
@@ -0,0 +1,72 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "ArenaBattle.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ABCombatEventSubsystem.generated.h"
+
+USTRUCT()
+struct FABCombatEventTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	class UABCombatEventSubsystem* Target = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FABCombatEventTickFunction> : public TStructOpsTypeTraitsBase2<FABCombatEventTickFunction>
+{
+	enum { WithCopy = false };
+};
+
+/**
+ * Per-frame queue of attack hits, resolved in one ordered pass in TG_PostUpdateWork instead of inside anim notifies.
+ * Kill rewards (exp, and the HUD and save updates behind it) raised during the pass are applied together once every hit has landed.
+ */
+UCLASS()
+class ARENABATTLE_API UABCombatEventSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	static bool IsEnabled();
+	void QueueHit(AActor* Target, float Damage, AController* EventInstigator, AActor* DamageCauser);
+
+	bool IsResolving() const;
+	void QueueKillReward(class AABPlayerController* Killer, class AABCharacter* KilledNPC);
+
+	void ResolveEvents();
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FCombatHit
+	{
+		TWeakObjectPtr<AActor>      Target;
+		TWeakObjectPtr<AController> EventInstigator;
+		TWeakObjectPtr<AActor>      DamageCauser;
+		float Damage = 0.0f;
+	};
+
+	struct FKillReward
+	{
+		TWeakObjectPtr<class AABPlayerController> Killer;
+		TWeakObjectPtr<class AABCharacter>        KilledNPC;
+	};
+
+	FABCombatEventTickFunction TickFunction;
+
+	// Hits queued while a pass runs go to the next frame; the two arrays swap so neither reallocates.
+	TArray<FCombatHit>  PendingHits;
+	TArray<FCombatHit>  ResolvingHits;
+	TArray<FKillReward> PendingKillRewards;
+	bool bResolving = false;
+};
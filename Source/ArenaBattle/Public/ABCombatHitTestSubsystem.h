@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "ArenaBattle.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ABCombatHitTestSubsystem.generated.h"
+
+// A sphere swept from Start to End, i.e. the capsule AttackCheck sweeps through the physics scene.
+struct FABSwing
+{
+	FVector Start;
+	FVector End;
+	float   Radius;
+};
+
+struct FABSwingHit
+{
+	int32 Swing;
+	int32 Combatant;
+};
+
+/**
+ * Structure-of-arrays copy of combatant capsules, stored as center, radius and half length of the vertical axis.
+ * The arrays are padded to a multiple of four so the kernel always loads whole vector registers.
+ */
+class ARENABATTLE_API FABCombatantBuffer
+{
+public:
+	void Reset();
+	int32 Add(const FVector& Center, float CapsuleRadius, float CapsuleHalfHeight);
+	int32 Num() const;
+
+	// Appends every overlapping (swing, combatant) pair, ordered by swing and then by combatant.
+	void TestSwings(TArrayView<const FABSwing> Swings, TArray<FABSwingHit>& OutHits) const;
+
+	// Scalar version of the same test, kept as the reference the vector kernel is checked against.
+	void TestSwingsScalar(TArrayView<const FABSwing> Swings, TArray<FABSwingHit>& OutHits) const;
+
+private:
+	TArray<float> CenterX;
+	TArray<float> CenterY;
+	TArray<float> CenterZ;
+	TArray<float> Radius;
+	TArray<float> AxisHalfLength;
+	int32 NumCombatants = 0;
+};
+
+/**
+ * Resolves every attack swing of the frame in one batch against the AABCharacter capsules, without touching the physics scene.
+ * The Attack trace channel only ever hits those capsules, so the analytic capsule-vs-capsule test gives the same targets.
+ */
+UCLASS()
+class ARENABATTLE_API UABCombatHitTestSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	static bool IsEnabled();
+	void QueueSwing(class AABCharacter* Attacker, const FVector& Start, const FVector& End, float SwingRadius);
+
+	// Fixed-seed crowd and swings shared by the timing harness and the kernel parity test.
+	static void MakeBenchmarkScenario(int32 NumCombatants, int32 NumSwings, FABCombatantBuffer& OutBuffer, TArray<FABSwing>& OutSwings);
+	static void RunBenchmark(int32 NumCombatants, int32 NumSwings, int32 Iterations);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void BuildCombatants();
+	void ValidateSwing(int32 SwingIndex, const TArray<FHitResult>& HitResults) const;
+
+	FABCombatantBuffer Combatants;
+	TArray<TWeakObjectPtr<class AABCharacter>> CombatantCharacters;
+
+	TArray<FABSwing> Swings;
+	TArray<TWeakObjectPtr<class AABCharacter>> SwingAttackers;
+	TArray<FABSwingHit> SwingHits;
+};
@@ -0,0 +1,40 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "ArenaBattle.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ABDetectScheduler.generated.h"
+
+/**
+ * Collects detection requests from UBTService_Detect and runs them under a per-frame time budget,
+ * nearest-to-player first. Whatever does not fit in the budget is deferred to the next frame.
+ */
+UCLASS()
+class ARENABATTLE_API UABDetectScheduler : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	static bool IsEnabled();
+	void RequestDetect(class UBehaviorTreeComponent& OwnerComp, float DetectRadius);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FDetectRequest
+	{
+		TWeakObjectPtr<class UBehaviorTreeComponent> OwnerComp;
+		float DetectRadius  = 0.0f;
+		int32 FramesWaiting = 0;
+		float Priority      = 0.0f;
+	};
+
+	void UpdatePriorities();
+
+	TArray<FDetectRequest> PendingRequests;
+};
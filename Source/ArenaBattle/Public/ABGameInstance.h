@@ -44,11 +44,19 @@ public:
 	UABGameInstance();
 
 	virtual void Init() override;
+	virtual void Shutdown() override;
 	FABCharacterData* GetABCharacterData(int32 Level);
 
+	void BenchmarkCharacterDataLookup(int32 Iterations) const;
 	
 private:
+	void CompileCharacterTable();
+
 	UPROPERTY()
 	class UDataTable* ABCharacterTable;
 
+	// ABCharacterTable rows indexed by Level - 1. Recompiled in place, so returned pointers survive a reload.
+	TArray<FABCharacterData> CharacterDataByLevel;
+	TArray<TArray<FABCharacterData>> RetiredCharacterData;
+
 };
@@ -0,0 +1,41 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "ArenaBattle.h"
+#include "Blueprint/UserWidget.h"
+#include "ABHPBarOverlayWidget.generated.h"
+
+/**
+ * Full-screen overlay that draws the HP bar of every nearby, visible character in a single paint pass.
+ * Replaces the per-character UI_HPBar widget components when UABCharacterSetting::bUseHPBarWidgetComponent is off.
+ */
+UCLASS(config=ArenaBattle)
+class ARENABATTLE_API UABHPBarOverlayWidget : public UUserWidget
+{
+	GENERATED_BODY()
+
+protected:
+	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+	virtual int32 NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+		FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+
+private:
+	struct FHPBar
+	{
+		FVector2D Position;
+		float     Ratio;
+		float     DistSq;
+	};
+
+	UPROPERTY(config)
+	float MaxDrawDistance = 2500.0f;
+
+	UPROPERTY(config)
+	int32 MaxBars = 32;
+
+	UPROPERTY(config)
+	FVector2D BarSize = FVector2D(80.0f, 8.0f);
+
+	TArray<FHPBar> Bars;
+};
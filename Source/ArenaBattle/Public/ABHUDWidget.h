@@ -20,13 +20,30 @@ public:
 
 protected:
 	virtual void NativeConstruct() override;
+	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+
+	// Only mark the HUD dirty; NativeTick applies whatever changed once per frame.
 	void UpdateCharacterStat();
 	void UpdatePlayerState();
 
 private:
+	void ApplyCharacterStat();
+	void ApplyPlayerState();
+	void SetNumberText(class UTextBlock* TextBlock, int32 Value, int32& CachedValue);
+
 	TWeakObjectPtr<class UABCharacterStatComponent> CurrentCharacterStat;
 	TWeakObjectPtr<class AABPlayerState> CurrentPlayerState;
 
+	bool bCharacterStatDirty = false;
+	bool bPlayerStateDirty   = false;
+
+	float   CachedHPRatio    = -1.0f;
+	float   CachedExpRatio   = -1.0f;
+	FString CachedPlayerName;
+	int32   CachedLevel      = INDEX_NONE;
+	int32   CachedScore      = INDEX_NONE;
+	int32   CachedHighScore  = INDEX_NONE;
+
 	UPROPERTY()
 	class UProgressBar* HPBar;
 	
@@ -6,6 +6,8 @@
 #include "GameFramework/Actor.h"
 #include "ABItem.generated.h"
 
+DECLARE_MULTICAST_DELEGATE(FOnItemClaimedDelegate);
+
 UCLASS()
 class ARENABATTLE_API AABItem : public AActor
 {
@@ -21,14 +23,19 @@ protected:
 	virtual void PostInitializeComponents() override;
 
 public:	
+	void ActivateItem();
+	void DeactivateItem();
+
+	FOnItemClaimedDelegate OnItemClaimed;
+
 	UPROPERTY(VisibleAnywhere, Category = Box)
 	UBoxComponent* Trigger;
 
 	UPROPERTY(VisibleAnywhere, Category = Box)
 	UStaticMeshComponent* Box;
 
-	UPROPERTY(VisibleAnywhere, Category = Effect)
-	UParticleSystemComponent* Effect;
+	UPROPERTY(EditDefaultsOnly, Category = Effect)
+	UParticleSystem* OpenEffect;
 
 	UPROPERTY(EditInstanceOnly, Category = Box)
 	TSubclassOf<class AABWeapon> WeaponItemClass;
@@ -37,7 +44,4 @@ private:
 	UFUNCTION()
 	void OnCharacterOverlap(UPrimitiveComponent* OVerlappedComp, AActor* OtherActor, 
 		UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
-
-	UFUNCTION()
-	void OnEffectFinished(class UParticleSystemComponent* PSystem);
 };
@@ -0,0 +1,48 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "ArenaBattle.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ABItemPoolSubsystem.generated.h"
+
+/**
+ * Recycles AABItem boxes and the particle components that play their chest-open burst.
+ */
+UCLASS(config=ArenaBattle)
+class ARENABATTLE_API UABItemPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	class AABItem* AcquireItem(const FVector& Location, const FRotator& Rotation);
+	void ReleaseItem(class AABItem* Item);
+
+	void PlayEffect(UParticleSystem* Template, const FTransform& Transform);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	UFUNCTION()
+	void OnEffectFinished(UParticleSystemComponent* PSystem);
+
+	void UpdateStats();
+
+	UPROPERTY(config)
+	int32 MaxPooledItems = 8;
+
+	UPROPERTY(config)
+	int32 MaxPooledEffects = 8;
+
+	UPROPERTY()
+	TArray<class AABItem*> AvailableItems;
+
+	UPROPERTY()
+	TArray<UParticleSystemComponent*> AvailableEffects;
+
+	int32 LiveItemCount   = 0;
+	int32 LiveEffectCount = 0;
+};
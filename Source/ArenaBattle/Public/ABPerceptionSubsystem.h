@@ -0,0 +1,64 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "ArenaBattle.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ABPerceptionSubsystem.generated.h"
+
+/**
+ * Uniform 2D spatial hash of every live AABCharacter, rebuilt once per frame.
+ * Detection queries only touch the cells overlapping the query radius instead of the physics scene.
+ */
+UCLASS()
+class ARENABATTLE_API UABPerceptionSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterCharacter(class AABCharacter* Character);
+	void UnregisterCharacter(class AABCharacter* Character);
+
+	class AABCharacter* FindPlayerInRadius(const FVector& Center, float Radius, const AActor* IgnoreActor = nullptr) const;
+	void QueryCharacters(const FVector& Center, float Radius, TArray<class AABCharacter*>& OutCharacters) const;
+	const TArray<TWeakObjectPtr<class AABCharacter>>& GetRegisteredCharacters() const;
+
+	void NotifyPhysicsQuery();
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FCellEntry
+	{
+		FIntPoint Cell;
+		FVector   Location;
+		TWeakObjectPtr<class AABCharacter> Character;
+	};
+
+	struct FCellSpan
+	{
+		int32 Start = 0;
+		int32 Num   = 0;
+	};
+
+	FIntPoint GetCellCoord(const FVector& Location) const;
+	void RebuildHash();
+	void UpdateQueryRates(float DeltaTime);
+
+	template<typename FunctorType>
+	void ForEachInRadius(const FVector& Center, float Radius, FunctorType&& Functor) const;
+
+	static constexpr float CellSize = 600.0f;
+
+	TArray<TWeakObjectPtr<class AABCharacter>> Characters;
+	TArray<FCellEntry> Entries;
+	TMap<FIntPoint, FCellSpan> Cells;
+
+	mutable int32 HashQueryCount    = 0;
+	int32         PhysicsQueryCount = 0;
+	float         QueryRateTime     = 0.0f;
+};
@@ -43,6 +43,9 @@ private:
 	UPROPERTY()
 	class UABHUDWidget* HUDWidget;
 
+	UPROPERTY()
+	class UABHPBarOverlayWidget* HPBarOverlayWidget;
+
 	UPROPERTY()
 	class AABPlayerState* ABPlayerState;
 
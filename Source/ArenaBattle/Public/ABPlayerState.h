@@ -27,13 +27,19 @@ public:
 	bool  AddExp(int32 IncomeExp);
 	void  AddGameScore();
 
+	// Starts an async load of the save slot; OnPlayerDataReady fires once it has been applied.
 	void InitPlayerData();
+	bool IsPlayerDataLoaded() const;
 	void SavePlayerData();
+	void WritePlayerData(struct FABProfileData& OutData) const;
 	FString SaveSlotName;
 
 	FOnPlayerStateChangedDelegate OnPlayerStateChanged;
+	FOnPlayerStateChangedDelegate OnPlayerDataReady;
 
 protected:
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	UPROPERTY(Transient)
 	int32 GameScore;
 
@@ -51,5 +57,8 @@ protected:
 
 private:
 	void SetCharacterLevel(int32 NewCharacterLevel);
-	struct FABCharacterData* CurrentStatData;
+	void ApplyLoadedPlayerData(const struct FABProfileData& Data);
+
+	struct FABCharacterData* CurrentStatData = nullptr;
+	bool bPlayerDataLoaded = false;
 };
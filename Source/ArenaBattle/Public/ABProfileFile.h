@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "ArenaBattle.h"
+
+struct FABProfileData
+{
+	FString PlayerName     = TEXT("Guest");
+	int32   Level          = 1;
+	int32   Exp            = 0;
+	int32   HighScore      = 0;
+	int32   CharacterIndex = 0;
+};
+
+/**
+ * Binary player profile : a CRC-checked header holding a full FABProfileData, followed by an append-only journal
+ * of single-field changes. Readers replay the journal up to the first record that fails its CRC,
+ * so a torn append only loses that append.
+ */
+class ARENABATTLE_API FABProfileFile
+{
+public:
+	static FString GetProfilePath(const FString& SlotName);
+
+	// OutNumRecords counts the journal records replayed; bOutTornTail is set when trailing bytes were dropped.
+	static bool Parse(const TArray<uint8>& Bytes, FABProfileData& OutData, int32& OutNumRecords, bool& bOutTornTail);
+
+	static void WriteSnapshot(const FABProfileData& Data, TArray<uint8>& OutBytes);
+
+	// Emits one record per changed numeric field. Returns false when the change needs a snapshot instead.
+	static bool WriteJournal(const FABProfileData& From, const FABProfileData& To, TArray<uint8>& OutBytes, int32& OutNumRecords);
+
+private:
+	enum class ERecordType : uint8
+	{
+		LEVEL           = 1,
+		EXP             = 2,
+		HIGHSCORE       = 3,
+		CHARACTERINDEX  = 4
+	};
+
+	static void WriteRecord(ERecordType Type, int32 Value, TArray<uint8>& OutBytes);
+
+	static constexpr uint32 Magic       = 0x46504241; // "ABPF"
+	static constexpr uint16 Version     = 1;
+	static constexpr int32  HeaderSize  = sizeof(uint32) + sizeof(uint16) + sizeof(uint16) + sizeof(uint32) + sizeof(uint32);
+	static constexpr int32  PayloadSize = sizeof(uint8) + sizeof(int32);
+	static constexpr int32  RecordSize  = PayloadSize + sizeof(uint32);
+};
@@ -0,0 +1,62 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "ArenaBattle.h"
+#include "ABProfileFile.h"
+
+struct FABProfileSummary
+{
+	FString PlayerName;
+	int32   Level          = 1;
+	int32   HighScore      = 0;
+	int32   CharacterIndex = 0;
+
+	static FABProfileSummary FromProfile(const FABProfileData& Data)
+	{
+		return { Data.PlayerName, Data.Level, Data.HighScore, Data.CharacterIndex };
+	}
+
+	bool operator==(const FABProfileSummary& Other) const
+	{
+		return PlayerName == Other.PlayerName && Level == Other.Level && HighScore == Other.HighScore && CharacterIndex == Other.CharacterIndex;
+	}
+};
+
+struct FABLeaderboardEntry
+{
+	FString SlotName;
+	FString PlayerName;
+	int32   Score = 0;
+};
+
+/**
+ * Summary of every profile slot plus the local top-N leaderboard, kept in one small file
+ * so the title screen can list players without opening their profiles.
+ */
+class ARENABATTLE_API FABProfileIndex
+{
+public:
+	static FString GetIndexPath();
+
+	bool Parse(const TArray<uint8>& Bytes);
+	void Write(TArray<uint8>& OutBytes) const;
+
+	// Returns true when the stored summary changed.
+	bool UpdateProfile(const FString& SlotName, const FABProfileSummary& Summary);
+	FString MakeUniqueSlotName(const FString& PlayerName) const;
+	const TMap<FString, FABProfileSummary>& GetProfiles() const { return Profiles; }
+
+	// Keeps each slot's best score. Returns true when the leaderboard changed.
+	bool SubmitScore(const FString& SlotName, const FString& PlayerName, int32 Score, int32 MaxEntries);
+	void GetLeaderboard(TArray<FABLeaderboardEntry>& OutEntries) const;
+
+private:
+	TMap<FString, FABProfileSummary> Profiles;
+
+	// Min-heap on Score, so the entry to displace is always at the top.
+	TArray<FABLeaderboardEntry> Leaderboard;
+
+	static constexpr uint32 Magic   = 0x49504241; // "ABPI"
+	static constexpr uint16 Version = 1;
+};
@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "ArenaBattle.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ABRandomSubsystem.generated.h"
+
+UENUM()
+enum class EABRandomStream : uint8
+{
+	LOOT,
+	SPAWN,
+	SKIN,
+	MAX UMETA(Hidden)
+};
+
+/**
+ * Per-world seeded random streams for gameplay rolls, one independent substream per EABRandomStream.
+ * Pass -ABSeed=<n> (benchmark runs default to 0) to make a run reproduce exactly; otherwise the seed is logged at startup.
+ */
+UCLASS(config=ArenaBattle)
+class ARENABATTLE_API UABRandomSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	// Worlds without the subsystem (editor previews) get a shared unseeded stream.
+	static FRandomStream& GetStream(const UObject* WorldContextObject, EABRandomStream Stream);
+	static FVector2D RandPointInCircle(FRandomStream& Stream, float Radius);
+
+	int32 GetSeed() const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	// Only used when neither -ABSeed nor -ABBenchmark is given and bRandomizeSeed is off.
+	UPROPERTY(config)
+	int32 DefaultSeed = 0;
+
+	UPROPERTY(config)
+	bool bRandomizeSeed = true;
+
+	int32 Seed = 0;
+	FRandomStream Streams[(int32)EABRandomStream::MAX];
+};
@@ -7,7 +7,7 @@
 #include "ABSaveGame.generated.h"
 
 /**
- * 
+ * Save slot format used before FABProfileFile. Only read to migrate existing players.
  */
 UCLASS()
 class ARENABATTLE_API UABSaveGame : public USaveGame
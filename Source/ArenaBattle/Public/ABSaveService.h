@@ -0,0 +1,85 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "ArenaBattle.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Containers/Ticker.h"
+#include "ABProfileFile.h"
+#include "ABProfileIndex.h"
+#include "ABSaveService.generated.h"
+
+DECLARE_DELEGATE_OneParam(FOnProfileLoadedDelegate, const FABProfileData&);
+
+/**
+ * Coalesces player data changes into occasional profile writes.
+ * Small changes are appended to the profile journal, everything else rewrites the profile through a temp file.
+ * Disk work runs on a worker, one request at a time and in the order it was issued.
+ */
+UCLASS(config=ArenaBattle)
+class ARENABATTLE_API UABSaveService : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	void MarkDirty(class AABPlayerState* PlayerState);
+	void Flush();
+	void WaitForPendingWrites();
+
+	void LoadProfileAsync(const FString& SlotName, FOnProfileLoadedDelegate OnLoaded);
+	void CreateProfile(const FString& SlotName, const FABProfileData& Data);
+	FString CreateNewProfile(const FABProfileData& Data);
+
+	const FString& GetActiveSlot() const { return ActiveSlotName; }
+	void SetActiveSlot(const FString& SlotName);
+
+	const FABProfileIndex& GetProfileIndex() const { return ProfileIndex; }
+	void SubmitHighScore(const FString& SlotName, const FString& PlayerName, int32 Score);
+	void DumpProfiles(FOutputDevice& Ar) const;
+
+private:
+	struct FSlotState
+	{
+		FABProfileData Persisted;
+		int32 JournalRecords = 0;
+		bool  bHasPersisted  = false;
+		bool  bNeedsSnapshot = false;
+	};
+
+	bool OnTick(float DeltaTime);
+	void SavePlayerState(class AABPlayerState* PlayerState);
+	void SaveProfile(const FString& SlotName, const FABProfileData& Data);
+	void OnProfileRead(const FString& SlotName, bool bParsed, FABProfileData Data, int32 NumRecords, bool bTornTail,
+		const TArray<uint8>& LegacyBytes, FOnProfileLoadedDelegate OnLoaded);
+	void QueueDiskTask(TUniqueFunction<void()> Task);
+	void WriteProfileIndex();
+
+	// Seconds a change may wait for others to join it before it is written.
+	UPROPERTY(config)
+	float CoalesceSeconds = 1.0f;
+
+	// Journal records allowed behind the header before the next save rewrites the profile.
+	UPROPERTY(config)
+	int32 JournalCompactionThreshold = 64;
+
+	UPROPERTY(config)
+	int32 LeaderboardSize = 10;
+
+	UPROPERTY(config)
+	FString ActiveSlotName = TEXT("Player1");
+
+	FABProfileIndex ProfileIndex;
+	bool bProfileIndexDirty = false;
+
+	TMap<FString, FSlotState> Slots;
+	TArray<TWeakObjectPtr<class AABPlayerState>> DirtyPlayerStates;
+	double FirstDirtyTime    = 0.0;
+	float  WorstGameThreadMs = 0.0f;
+
+	// Disk tasks are chained so an older snapshot can never land after a newer one.
+	TFuture<void> LastDiskTask;
+	FTSTicker::FDelegateHandle TickerHandle;
+};
@@ -19,6 +19,7 @@ public:
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 private:
 	enum class ESectionState : uint8
@@ -41,10 +42,21 @@ private:
 	void OnGateTriggerBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
 		UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
 
-	UFUNCTION()
-	void OnKeyNPCDestroyed(AActor* DestroyedActor);
+	void OnKeyNPCRemoved(class AABCharacter* ABCharacter);
+
+	void PreloadKeyNPCAsset();
+	void ReleaseKeyNPCAsset();
+
+	void AcquireItemBox(const FVector& Location);
+	void OnItemBoxClaimed();
 
 public:
+	bool IsBattleInProgress() const;
+	bool IsCompleted() const;
+	float GetGridStep() const;
+
+	void ActivateSection(const FVector& Location, const struct FABSectionCell& Record);
+	void DeactivateSection(struct FABSectionCell& OutRecord);
 
 private:
 	UPROPERTY(VisibleAnywhere, Category = Mesh, Meta = (AllowPrivateAccess = true))
@@ -71,4 +83,9 @@ private:
 	FTimerHandle SpawnNPCTimerHandle     = {};
 	FTimerHandle SpawnItemBoxTimerHandle = {};
 
+	int32 KeyNPCAssetIndex = INDEX_NONE;
+	TSharedPtr<struct FABSkinHandle> KeyNPCAssetHandle;
+
+	TWeakObjectPtr<class AABItem> ItemBox;
+
 };
@@ -0,0 +1,57 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "ArenaBattle.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ABSectionGridSubsystem.generated.h"
+
+struct FABSectionCell
+{
+	TWeakObjectPtr<class AABSection> Section;
+	bool bCompleted = false;
+
+	// An item box the player left behind, relative to the section, put back when the cell is restored.
+	bool    bHasItemBox   = false;
+	FVector ItemBoxOffset = FVector::ZeroVector;
+};
+
+/**
+ * Integer-grid index of every placed AABSection, keyed by cell.
+ * A cell stays occupied while its section is collapsed by streaming, so placement checks are a single hash lookup.
+ */
+UCLASS()
+class ARENABATTLE_API UABSectionGridSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	void RegisterSection(class AABSection* Section);
+	void UnregisterSection(class AABSection* Section);
+
+	bool IsGridInitialized() const { return GridStep > 0.0f; }
+	FIntPoint WorldToCell(const FVector& Location) const;
+	FVector CellToWorld(const FIntPoint& Cell) const;
+
+	bool IsCellOccupied(const FIntPoint& Cell) const;
+	class AABSection* GetSectionAt(const FIntPoint& Cell) const;
+	void GetOccupiedNeighbors(const FIntPoint& Cell, TArray<FIntPoint>& OutNeighbors) const;
+
+	void SetSection(const FIntPoint& Cell, class AABSection* Section);
+	void CollapseCell(const FIntPoint& Cell, const FABSectionCell& Record);
+	const TMap<FIntPoint, FABSectionCell>& GetCells() const { return Cells; }
+
+	// Round-trips the arena layout. Loaded cells come back collapsed and are restored by streaming.
+	// Loading is only allowed before any section has registered.
+	void SerializeLayout(FArchive& Ar);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	TMap<FIntPoint, FABSectionCell> Cells;
+	FVector GridOrigin = FVector::ZeroVector;
+	float   GridStep   = 0.0f;
+};
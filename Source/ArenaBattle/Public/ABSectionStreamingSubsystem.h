@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "ArenaBattle.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ABSectionStreamingSubsystem.generated.h"
+
+/**
+ * Keeps only the AABSections within StreamingRadius cells of a player alive.
+ * Sections further away are recycled into a pool and left as a collapsed cell in UABSectionGridSubsystem,
+ * then restored from that cell when a player comes back.
+ */
+UCLASS(config=ArenaBattle)
+class ARENABATTLE_API UABSectionStreamingSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	class AABSection* AcquireSection(const FIntPoint& Cell, const struct FABSectionCell& Record);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void UpdateStreaming();
+	void CollapseSection(const FIntPoint& Cell, class AABSection* Section);
+	void UpdateStats();
+
+	UPROPERTY(config)
+	int32 StreamingRadius = 2;
+
+	UPROPERTY(config)
+	int32 MaxPooledSections = 8;
+
+	UPROPERTY(config)
+	float UpdateInterval = 0.5f;
+
+	UPROPERTY()
+	TArray<class AABSection*> AvailableSections;
+
+	UPROPERTY()
+	class UABSectionGridSubsystem* SectionGrid;
+
+	FTimerHandle UpdateTimerHandle = {};
+};
@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "ArenaBattle.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ABSignificanceSubsystem.generated.h"
+
+UENUM()
+enum class EABSignificanceTier : uint8
+{
+	HIGH,
+	MEDIUM,
+	LOW,
+	MAX UMETA(Hidden)
+};
+
+/**
+ * Sorts NPCs into significance tiers by distance to the nearest player and on-screen visibility.
+ * Lower tiers tick their behavior tree, movement and animation less often.
+ */
+UCLASS()
+class ARENABATTLE_API UABSignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterCharacter(class AABCharacter* Character);
+	void UnregisterCharacter(class AABCharacter* Character);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FTrackedCharacter
+	{
+		TWeakObjectPtr<class AABCharacter> Character;
+		EABSignificanceTier Tier = EABSignificanceTier::MAX;
+	};
+
+	EABSignificanceTier CalculateTier(const class AABCharacter* Character, TArrayView<const FVector> PlayerLocations) const;
+	void ApplyTier(class AABCharacter* Character, EABSignificanceTier Tier) const;
+
+	TArray<FTrackedCharacter> TrackedCharacters;
+	float TimeSinceUpdate = 0.0f;
+};
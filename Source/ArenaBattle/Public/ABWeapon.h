@@ -19,6 +19,9 @@ public:
 	float GetAttackDamage() const;
 	float GetAttackModifier() const;
 
+	void ApplyWeaponData(TSubclassOf<AABWeapon> WeaponClass);
+	void RollStats();
+
 	UPROPERTY(VisibleAnywhere, Category = Weapon)
 	USkeletalMeshComponent* Weapon;
 
@@ -47,6 +50,9 @@ protected:
 	UPROPERTY(Transient, VisibleInstanceOnly, BlueprintReadOnly, Category = Attack)
 	float AttackModifier;
 
+	UPROPERTY(Transient)
+	TSubclassOf<AABWeapon> AppliedWeaponClass;
+
 public:	
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
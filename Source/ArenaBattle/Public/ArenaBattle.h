@@ -3,6 +3,7 @@
 #pragma once
 
 #include "EngineMinimal.h"
+#include "ProfilingDebugging/CsvProfiler.h"
 
 UENUM(BlueprintType)
 enum class ECharacterState : uint8
@@ -14,6 +15,16 @@ enum class ECharacterState : uint8
 };
 
 DECLARE_LOG_CATEGORY_EXTERN(ArenaBattle, Log, All);
+DECLARE_STATS_GROUP(TEXT("ArenaBattle"), STATGROUP_ArenaBattle, STATCAT_Advanced);
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(ARENABATTLE_API, ArenaBattle);
+
+// Cycle counter that also shows up in Insights and in CSV captures. Builds without stats still get the trace scope.
+#if STATS
+#define AB_SCOPE_CYCLE_COUNTER(Stat) SCOPE_CYCLE_COUNTER(Stat); CSV_SCOPED_TIMING_STAT(ArenaBattle, Stat)
+#else
+#define AB_SCOPE_CYCLE_COUNTER(Stat) TRACE_CPUPROFILER_EVENT_SCOPE(Stat); CSV_SCOPED_TIMING_STAT(ArenaBattle, Stat)
+#endif
+
 #define ABLOG_CALLINFO (FString(__FUNCTION__) + TEXT("(") + FString::FromInt(__LINE__) + TEXT(")"))
 #define ABLOG_S(Verbosity) UE_LOG(ArenaBattle, Verbosity, TEXT("%s"), *ABLOG_CALLINFO)
 #define ABLOG(Verbosity, Format, ...) UE_LOG(ArenaBattle, Verbosity, TEXT("%s%s"), *ABLOG_CALLINFO, *FString::Printf(Format, ##__VA_ARGS__))
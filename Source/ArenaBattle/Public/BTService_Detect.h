@@ -17,7 +17,11 @@ class ARENABATTLE_API UBTService_Detect : public UBTService
 public:
 	UBTService_Detect();
 
+	static void DetectTarget(UBehaviorTreeComponent& OwnerComp, float DetectRadios);
+
 protected:
 	virtual void TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
-	
+
+private:
+	static class AABCharacter* FindPlayerByOverlap(APawn* ControllingPawn, const FVector& Center, float DetectRadios);
 };
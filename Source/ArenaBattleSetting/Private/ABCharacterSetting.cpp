@@ -5,4 +5,5 @@
 
 UABCharacterSetting::UABCharacterSetting()
 {
+	bUseHPBarWidgetComponent = true;
 }
@@ -19,4 +19,8 @@ public:
 
 	UPROPERTY(config)
 	TArray<FSoftObjectPath> CharacterAssets;
+
+	// When false, characters get no UI_HPBar widget component and UABHPBarOverlayWidget draws every HP bar instead.
+	UPROPERTY(config)
+	bool bUseHPBarWidgetComponent;
 };